@@ -0,0 +1,226 @@
+#pragma once
+
+
+// includes
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include "time_zone.hpp"
+#include "timepoint.hpp"
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: converts a calendar time to local time, on any platform
+// requires: the time and a tm to fill in
+// returns: false if it couldn't be converted
+bool localTime(std::time_t, std::tm&);
+
+class Clock;
+
+// purpose: makes a clock the one everything reads the time from, it has
+//          to outlive its use
+// requires: the clock
+// returns: nothing
+void useClock(Clock&);
+
+// purpose: gets the time from the clock in use
+// requires: nothing
+// returns: the time, to the minute
+TimePoint currentTime();
+
+
+    /*********\
+    *  Clock  *
+    \*********/
+
+// where "now" comes from, so it can be pinned for benchmarks and tests or
+// sped up to run weeks of a list in seconds
+class Clock
+{
+public:
+
+    virtual ~Clock() = default;
+
+    // purpose: gets the local time
+    // requires: nothing
+    // returns: the time, to the minute
+    virtual TimePoint now() const = 0;
+};
+
+
+    /***************\
+    *  SystemClock  *
+    \***************/
+
+// the machine's clock in local time, by the system's time zone
+class SystemClock : public Clock
+{
+public:
+
+    TimePoint now() const override;
+};
+
+
+    /**************\
+    *  FixedClock  *
+    \**************/
+
+// a clock that only moves when it's told to
+class FixedClock : public Clock
+{
+public:
+
+    // purpose: stops the clock at a time
+    // requires: the time
+    // returns: nothing
+    explicit FixedClock(const TimePoint& time) : minutes(time.toMinutes()) { }
+
+    TimePoint now() const override
+    {
+        return TimePoint::fromMinutes(minutes.load());
+    }
+
+    // purpose: moves the clock to a time
+    // requires: the time
+    // returns: nothing
+    void set(const TimePoint& time) { minutes = time.toMinutes(); }
+
+    // purpose: moves the clock forward
+    // requires: the number of minutes, negative to go back
+    // returns: nothing
+    void advance(long long by) { minutes += by; }
+
+private:
+
+    // minutes since 1970/01/01 0000
+    std::atomic<long long> minutes;
+};
+
+
+    /******************\
+    *  SimulatedClock  *
+    \******************/
+
+// a clock that starts at a given time and runs some number of times
+// faster (or slower) than real time, and can be jumped forward on top
+class SimulatedClock : public Clock
+{
+public:
+
+    // purpose: starts the clock
+    // requires: the time it starts at, and optionally how many simulated
+    //           seconds go by for every real one
+    // returns: nothing
+    SimulatedClock(const TimePoint&, double speed);
+
+    TimePoint now() const override;
+
+    // purpose: jumps the clock forward
+    // requires: the number of minutes, negative to go back
+    // returns: nothing
+    void advance(long long by) { jumped += by; }
+
+    // purpose: gets how fast the clock runs
+    // requires: nothing
+    // returns: the simulated seconds per real second
+    double speed() const { return rate; }
+
+private:
+
+    long long start;
+    double rate;
+    std::chrono::steady_clock::time_point started;
+    std::atomic<long long> jumped{ 0 };
+};
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the clock in use until another is put in
+SystemClock SYSTEM_CLOCK;
+
+// the clock everything reads the time from
+std::atomic<Clock*> CURRENT_CLOCK{ &SYSTEM_CLOCK };
+
+
+    /*****************\
+    *  clock methods  *
+    \*****************/
+
+// read the machine's clock
+TimePoint SystemClock::now() const
+{
+    std::time_t seconds = std::chrono::system_clock::to_time_t(
+        std::chrono::system_clock::now());
+    ZoneId zone = ZONES.local();
+    std::tm local{};
+
+    // the system's zone is read once, after that it's a table lookup
+    if (zone != 0)
+        return TimePoint::fromMinutes(ZONES.zone(zone).toLocal(
+            static_cast<long long>(seconds) / 60));
+
+    // tm_year is years since 1900, and tm_mon is 0-based
+    if (!localTime(seconds, local))
+        return TimePoint(1970, Months::January, 1, 0, 0);
+
+    return TimePoint(local.tm_year + 1900,
+        static_cast<Months>(local.tm_mon + 1), local.tm_mday, local.tm_hour,
+        local.tm_min);
+}
+
+// start the simulated clock
+SimulatedClock::SimulatedClock(const TimePoint& time, double speed = 1.0)
+    : start(time.toMinutes()), rate(speed),
+    started(std::chrono::steady_clock::now())
+{
+}
+
+// read the simulated clock
+TimePoint SimulatedClock::now() const
+{
+    std::chrono::duration<double> real = std::chrono::steady_clock::now()
+        - started;
+
+    return TimePoint::fromMinutes(start + jumped.load()
+        + static_cast<long long>(std::floor(real.count() * rate / 60)));
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// convert to local time
+bool localTime(std::time_t seconds, std::tm& local)
+{
+#ifdef _WIN32
+    return localtime_s(&local, &seconds) == 0;
+#else
+    return localtime_r(&seconds, &local) != nullptr;
+#endif
+}
+
+// switch clocks
+void useClock(Clock& clock)
+{
+    CURRENT_CLOCK = &clock;
+}
+
+// read the clock in use
+TimePoint currentTime()
+{
+    return CURRENT_CLOCK.load()->now();
+}
+
+// the default time point is right now, by the clock in use
+TimePoint::TimePoint() : TimePoint(currentTime())
+{
+}
@@ -3,10 +3,24 @@
 
 // includes
 
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include "../memory/arena.hpp"
+#include "../memory/cold_store.hpp"
+#include "../memory/intern.hpp"
+#include "clock.hpp"
+#include "month_codec.hpp"
+#include "recurrence.hpp"
+#include "time_zone.hpp"
 #include "timepoint.hpp"
 
 
@@ -15,14 +29,27 @@
 using std::cin;
 using std::cout;
 using std::string;
+using std::string_view;
 
 
     /*************\ 
     *  constants  *
     \*************/
 
-// the time at compile time
-const TimePoint NOW;
+// the time priorities are worked out from, read off the clock when the
+// program starts, and moved up to the clock's time by whoever owns the
+// list (every priority has to be worked out again when it moves)
+TimePoint NOW = currentTime();
+
+// the arena the titles of the list live in
+// everything in it is given back at once when the list is reloaded
+Arena LIST_ARENA;
+
+// every distinct event title, kept once in the list arena
+SymbolTable TITLES(LIST_ARENA);
+
+// the descriptions of the list, only looked at when an event is shown
+ColdStore DESCRIPTIONS;
 
 // a constant used to scale the priority of an event
 constexpr double PRIORITY_CONST = 896.0;
@@ -32,12 +59,27 @@ constexpr double PRIORITY_CONST = 896.0;
     *  prototypes  *
     \**************/
 
-// purpose: gets the year, month, day, hour, and minute from a string
-//          (all integer format)
+// purpose: gets the year, month, day, hour, and minute from a string,
+//          either "MM DD YYYY HH MM" (military time, the fields separated
+//          by spaces or slashes) or ISO 8601, "YYYY-MM-DD" with an
+//          optional "THH:MM" or " HH:MM" (seconds are allowed and dropped,
+//          a date alone is due at noon), without allocating anything
 // requires: a string representing the timepoint,
 //           and 5 ints to store the values
-// returns: the year, month, day, hour, and minute in integer format
-void formatDate(const string&, int&, int&, int&, int&, int&);
+// returns: the year, month, day, hour, and minute in integer format,
+//          throws invalid_argument if it isn't a date and time that exist
+void formatDate(string_view, int&, int&, int&, int&, int&);
+
+// purpose: reads a due date the way formatDate does
+// requires: a string
+// returns: the time point, throws invalid_argument if it isn't one
+TimePoint parseDueDate(string_view);
+
+// purpose: reads a number at the front of a date and drops it
+// requires: the rest of the date, where to put the number, and how few
+//           and how many digits it can have
+// returns: false if there aren't enough digits there
+bool readDateNumber(string_view&, int&, size_t least, size_t most);
 
 // purpose: reads all the info necessary to create an event from the console   
 // requires: a string, 5 ints, a month, and a double
@@ -45,22 +87,29 @@ void formatDate(const string&, int&, int&, int&, int&, int&);
 void readEventInfo(string&, int&, Months&,
     int&, int&, int&, unsigned short&, double&);
 
-// purpose: converts a string to month
-// requires: a string
-// returns: a month
-Months stom(std::string);
+// purpose: packs a due date into the minutes an event keeps
+// requires: a time point
+// returns: the minutes since 1970/01/01 0000,
+//          throws out_of_range if it doesn't fit in 32 bits
+std::int32_t packDueDate(const TimePoint&);
 
-// purpose: converts a month to a string
-// requires: a month
-// returns: a string
-string mtos(Months month);
+// purpose: puts a number read out of a file into a whole number field, a
+//          fraction, or a number the field can't hold, is left out like a
+//          value of the wrong type
+// requires: the number and the field
+// returns: false if it was left out, and then the field isn't touched
+template <typename whole>
+bool readWholeNumber(double, whole&);
 
 
     /*********\
     *  Event  *
     \*********/
 
-// an event holds the title, due date, importance, and user-imposed bias
+class JSONWriter;
+
+// an event holds the title, due date, importance, and user-imposed bias,
+// and when the due date happens: the time zone it's in and how it repeats
 // will automatically calculate the priority of itself
 class Event
 {
@@ -74,12 +123,8 @@ public:
     Event();
 
     // parametrized constructor
-    Event(string, const TimePoint&, unsigned short, double, string);
-
-    // copy constructor
-    Event(const Event&);
-
-    ~Event();
+    // the title is interned and the description goes in the cold store
+    Event(string_view, const TimePoint&, unsigned short, double, string_view);
 
     /**********************\
     *  accessor functions  *
@@ -88,17 +133,55 @@ public:
     // get the user-imposed bias
     double get_bias() const { return bias; }
 
-    // get the description of the event
-    string get_description() const { return description; }
+    // get the description of the event, good until the list is reloaded
+    string_view get_description() const { return DESCRIPTIONS.get(details); }
+
+    // get the id of the event, 0 until the shell hands one out
+    unsigned get_id() const { return id; }
 
     // get the base importance of the event
     int get_importance() const { return importance; }
 
-    // get the name of the event
-    string get_name() const { return title; }
+    // get the name of the event, good until the list is reloaded
+    string_view get_name() const { return TITLES.name(title); }
+
+    // get the interned name of the event, equal names have equal symbols
+    Symbol get_title() const { return title; }
+
+    // get the due date of the event, unpacked from the minutes
+    TimePoint get_due_date() const { return TimePoint::fromMinutes(due); }
+
+    // get the due date as minutes since 1970, for comparing
+    std::int32_t get_due_minutes() const { return due; }
+
+    // get the priority of the event, worked out when it last changed
+    double get_priority() const { return priority; }
 
-    // get the due date of the event
-    TimePoint get_due_date() const { return *dueDate; }
+    // get the id of the event's schedule, equal schedules have equal ids
+    ScheduleId get_schedule() const { return schedule; }
+
+    // get the time zone the due date is in, 0 if it floats with the clock
+    ZoneId get_zone() const { return SCHEDULES.get(schedule).zone; }
+
+    // get how the event repeats, its frequency is None if it doesn't
+    const Recurrence& get_repeat() const
+    {
+        return SCHEDULES.get(schedule).repeat;
+    }
+
+    // find out if the event comes back after it's finished
+    bool is_recurring() const
+    {
+        return get_repeat().frequency != Frequency::None;
+    }
+
+    // get the due date in the clock's local time, as minutes since 1970
+    long long get_local_due_minutes() const
+    {
+        ZoneId zone = get_zone();
+
+        return zone == 0 ? due : ZONES.convert(due, zone, 0);
+    }
 
 
     /*********************\
@@ -106,16 +189,43 @@ public:
     \*********************/
 
     // change the bias
-    void set_bias(double nb) { bias = nb; }
+    void set_bias(double nb) { bias = nb; refresh_priority(); }
+
+    // give the event its id
+    void set_id(unsigned nid) { id = nid; }
 
     // update the event's due date
-    void set_due_date(TimePoint& ndd) { dueDate = &ndd; }
+    void set_due_date(const TimePoint& ndd)
+    {
+        due = packDueDate(ndd);
+        refresh_priority();
+    }
 
     // change the base importance of the event
-    void set_importance(int i) { importance = i; }
+    void set_importance(int i) { importance = i; refresh_priority(); }
 
     // change the name of the event
-    void set_name(string name) { title = name; }
+    void set_name(string_view name) { title = TITLES.intern(name); }
+
+    // put the due date in a time zone, 0 for none, the date keeps its
+    // fields and only when they happen moves
+    void set_zone(ZoneId);
+
+    // make the event repeat, or stop it with a blank rule
+    void set_repeat(const Recurrence&);
+
+    // purpose: moves a recurring event on to its next occurrence, for
+    //          when this one is finished
+    // requires: nothing
+    // returns: false if it doesn't repeat or its rule has run out, and
+    //          then it's left as it is
+    bool next_occurrence();
+
+    // purpose: works the priority of the event out again, for when the
+    //          time it's measured from moves
+    // requires: nothing
+    // returns: nothing
+    void refresh_priority();
 
 
     /************************\
@@ -157,25 +267,44 @@ public:
     // returns: the output stream
     friend std::ostream& operator<<(std::ostream& os, const Event& thing);
 
-    // purpose: copy assignment for an event
-    // requires: another event
-    // returns: an event
-    Event& operator=(const Event& other);
+    // purpose: appends the event to a text buffer, laid out like operator<<
+    // requires: a buffer and an event
+    // returns: nothing
+    friend void renderEvent(string& out, const Event& thing);
+
+    // purpose: estimates the size of the rendered event
+    // requires: an event
+    // returns: the number of bytes
+    friend size_t renderSizeHint(const Event& thing);
+
+    // purpose: writes the event as a compact json object
+    // requires: a json writer and an event
+    // returns: nothing
+    friend void writeEventJSON(JSONWriter& writer, const Event& thing);
 
 private:
-    unsigned short importance;
+    // the event is the hot record the heap and the sorted view move
+    // around, so it's kept to 32 bytes, two to a cache line
+    // the priority is only a sort key, so a float is plenty, it's held
+    // to FLT_MAX (see refresh_priority) so it can't overflow to inf
     double bias;
-    string description;
-    string title;
-    TimePoint* dueDate;
-
-    // purpose: determines the priority of the event
-    // requires: nothing
-    // returns: a double
-    double get_priority() const;
+    float priority;
+    // minutes since 1970/01/01 0000
+    std::int32_t due;
+    // the strings live outside the event, so copying an event is cheap,
+    // equal titles are the same symbol and the description is a cold slot
+    Symbol title;
+    ColdStore::Slot details;
+    unsigned id;
+    unsigned short importance;
+    // the time zone and recurrence, from SCHEDULES, filling what would be
+    // padding
+    ScheduleId schedule;
 
 };
 
+static_assert(sizeof(Event) <= 32, "the hot event record has to stay small");
+
 
     /**********************\
     *  Event constructors  *
@@ -184,36 +313,30 @@ private:
 // default constructor
 Event::Event()
 {
+    // no id yet
+    id = 0;
     // normal importance
     importance = 1;
     // no bias
     bias = 0.0;
-    // blank title
-    title = "";
-    // right now
-    dueDate = new TimePoint();
-    // blank description
-    description = "";
+    // blank title and description
+    title = 0;
+    details = ColdStore::EMPTY;
+    // the due date starts out as right now, in local time, and happens
+    // once
+    schedule = 0;
+    due = packDueDate(TimePoint());
+
+    refresh_priority();
 }
 
 // parametrized constructor
-Event::Event(string t, const TimePoint& d, unsigned short i = 1,
-    double b = 0.0, string des = "") : title(t), dueDate(new TimePoint(d)),
-    importance(i), bias(b), description(des) { }
-
-// copy constructor
-// default setup for most
-Event::Event(const Event& other) : title(other.title),
-importance(other.importance), bias(other.bias), description(other.description)
-{
-    // set up the due date
-    dueDate = new TimePoint(*other.dueDate);
-}
-
-// destructor
-Event::~Event()
+Event::Event(string_view t, const TimePoint& d, unsigned short i = 1,
+    double b = 0.0, string_view des = "") : bias(b), due(packDueDate(d)),
+    title(TITLES.intern(t)), details(DESCRIPTIONS.store(des)), id(0),
+    importance(i), schedule(0)
 {
-    delete dueDate;
+    refresh_priority();
 }
 
 
@@ -225,55 +348,55 @@ Event::~Event()
 bool operator<(const Event& a, const Event& b)
 {
     // if a is more important
-    if (a.get_priority() > b.get_priority())
+    if (a.priority > b.priority)
         return false;
     // if a is less important
-    else if (a.get_priority() < b.get_priority())
+    else if (a.priority < b.priority)
         return true;
     // if the priorities are the same
     // compare by the due dates
-    else if (a.get_due_date() > b.get_due_date())
+    else if (a.due > b.due)
         // a is less important if it comes later 
         return true;
     // if a doesn't come after b, check if it comes before
-    else if (a.get_due_date() < b.get_due_date())
+    else if (a.due < b.due)
         // a is more important if it comes before b
         return false;
     // if, by some miracle they're still the same priority
     else
         // compare by name
-        return a.get_name() < b.get_name();
+        return TITLES.name(a.title) < TITLES.name(b.title);
 }
 
 // find out if a > b based on priority
 bool operator>(const Event& a, const Event& b)
 {
     // if a is more important
-    if (a.get_priority() < b.get_priority())
+    if (a.priority < b.priority)
         return false;
     // if a is less important
-    else if (a.get_priority() > b.get_priority())
+    else if (a.priority > b.priority)
         return true;
     // if the priorities are the same
     // compare by the due dates
-    else if (a.get_due_date() < b.get_due_date())
+    else if (a.due < b.due)
         // a is less important if it comes later 
         return true;
     // if a doesn't come after b, check if it comes before
-    else if (a.get_due_date() > b.get_due_date())
+    else if (a.due > b.due)
         // a is more important if it comes before b
         return false;
     // if, by some miracle they're still the same priority
     else
         // compare by name
-        return a.get_name() > b.get_name();
+        return TITLES.name(a.title) > TITLES.name(b.title);
 }
 
 // find out if a == b based on event data
 bool operator==(const Event& a, const Event& b)
 {
     // if a and b don't have the same due date
-    if (a.get_due_date() != b.get_due_date())
+    if (a.due != b.due || a.schedule != b.schedule)
         return false;
     // if the biases are not the same
     else if (a.get_bias() != b.get_bias())
@@ -282,9 +405,9 @@ bool operator==(const Event& a, const Event& b)
     else if (a.get_importance() != b.get_importance())
         return false;
     // if the names are not the same
-    else if (a.get_name() != b.get_name())
+    else if (a.title != b.title)
         return false;
-    else if (a.get_description() != b.get_description())
+    else if (DESCRIPTIONS.get(a.details) != DESCRIPTIONS.get(b.details))
         return false;
     else
         return true;
@@ -298,7 +421,7 @@ bool operator!=(const Event& a, const Event& b)
         return true;
     // if the priorities are the same
     // compare by the due dates
-    else if (a.get_due_date() != b.get_due_date())
+    else if (a.due != b.due || a.schedule != b.schedule)
         // a is less important if it comes later 
         return true;
     // if a doesn't come after b, check if it comes before
@@ -306,37 +429,30 @@ bool operator!=(const Event& a, const Event& b)
         // a is more important if it comes before b
         return true;
     // if, by some miracle they're still the same priority
-    else if (a.get_name() != b.get_name())
+    else if (a.title != b.title)
         return true;
-    else if (a.get_description() != b.get_description())
+    else if (DESCRIPTIONS.get(a.details) != DESCRIPTIONS.get(b.details))
         return true;
     else
         return false;
 }
 
-// copy operator
-// written by DeepSeek
-Event& Event::operator=(const Event& other)
-{
-    if (this != &other)
-    {
-        title = other.title;
-        importance = other.importance;
-        bias = other.bias;
-        description = other.description;
-        delete dueDate;
-        dueDate = new TimePoint(*other.dueDate);
-    }
-    return *this;
-}
-
 // print the event to the ostream
 std::ostream& operator<<(std::ostream& os, const Event& thing)
 {
     os << thing.get_name();
-    if(thing.get_description() != "")
+    if(!thing.get_description().empty())
         os << "\n\t" << thing.get_description();
     os << "\nDue by " << thing.get_due_date();
+    if (thing.get_zone() != 0)
+        os << ' ' << ZONES.zone(thing.get_zone()).name();
+    if (thing.is_recurring())
+    {
+        char text[RECURRENCE_TEXT_SIZE];
+
+        os << "\nRepeats: " << string_view(text,
+            formatRecurrence(text, thing.get_repeat()) - text);
+    }
     os << "\nImportance: " << thing.get_importance();
     os << "\nBias: " << thing.get_bias();
     os << "\nPriority Level: " << thing.get_priority() << "\n";
@@ -345,25 +461,75 @@ std::ostream& operator<<(std::ostream& os, const Event& thing)
 }
 
 
-    /***************************\
-    *  event private functions  *
-    \***************************/
+    /*******************\
+    *  event functions  *
+    \*******************/
 
-// get the priority of the event
-double Event::get_priority() const
+// work out the priority of the event
+void Event::refresh_priority()
 {
     /*
     \frac{ importance }
     { ln( \frac{ e^{bias} + e^{time until due date} + 1 } { e^{bias} + 1 } ) }
     */
 
-    // calculate the denominator
-    double den = std::exp(bias) + std::exp(*dueDate - NOW) + 1;
-    den /= (std::exp(bias) + 1);
-    den = std::log(den);
+    // a zoned due date is measured in the clock's time, which the table
+    // of the zone's changes gives without asking the system
+    TimePoint local = TimePoint::fromMinutes(get_local_due_minutes());
+
+    // calculate the denominator, as ln(1 + e^{time} / (e^{bias} + 1)) so
+    // it doesn't round to 0 (and the priority to inf) once the event is a
+    // day and a half overdue
+    double den = std::log1p(std::exp(local - NOW) / (std::exp(bias) + 1));
+
+    // this is the equation that determines priority, held to what a float
+    // can take before narrowing, since anything overdue by more than about
+    // 80 hours is past it, those all tie and the most overdue comes first
+    priority = static_cast<float>(std::min(
+        PRIORITY_CONST * importance / den, static_cast<double>(FLT_MAX)));
+}
+
+// put the due date in a time zone
+void Event::set_zone(ZoneId nz)
+{
+    Schedule changed = SCHEDULES.get(schedule);
+
+    changed.zone = nz;
+    schedule = SCHEDULES.intern(changed);
+
+    refresh_priority();
+}
+
+// make the event repeat
+void Event::set_repeat(const Recurrence& rule)
+{
+    Schedule changed = SCHEDULES.get(schedule);
+
+    changed.repeat = rule;
 
-    // this is the equation that determines priority
-    return PRIORITY_CONST * importance / den;
+    // a rule by the day of the month remembers the day it started on, or
+    // after the 30th of April the 31st of May would be missed
+    if ((rule.frequency == Frequency::Monthly
+        || rule.frequency == Frequency::Yearly) && rule.week == 0
+        && rule.monthDay == 0)
+        changed.repeat.monthDay = static_cast<std::uint8_t>(
+            get_due_date().day);
+
+    schedule = SCHEDULES.intern(changed);
+}
+
+// move on to the next occurrence
+bool Event::next_occurrence()
+{
+    long long next = due;
+
+    if (!nextOccurrence(get_repeat(), next) || next > INT32_MAX)
+        return false;
+
+    due = static_cast<std::int32_t>(next);
+    refresh_priority();
+
+    return true;
 }
 
 
@@ -371,48 +537,93 @@ double Event::get_priority() const
     *  definitions  *
     \***************/
 
-// format the date from a string
-void formatDate(const string& date, int& y, int& mon, int& d, int& h, int& min)
+// get the date out of a string
+void formatDate(string_view date, int& y, int& mon, int& d, int& h,
+    int& min)
 {
-    string year = date.substr(0, 4);
-    string month = date.substr(5, 7);
-    string day = date.substr(8, 10);
-    string time = date.substr(11);
+    string_view rest = date;
+    bool good;
+
+    // white space around the date doesn't count
+    while (!rest.empty() && (rest.front() == ' ' || rest.front() == '\t'))
+        rest.remove_prefix(1);
+    while (!rest.empty() && (rest.back() == ' ' || rest.back() == '\t'
+        || rest.back() == '\r'))
+        rest.remove_suffix(1);
+
+    // takes a separator off the front
+    auto skip = [&rest](char separator)
+    {
+        if (rest.empty() || rest.front() != separator)
+            return false;
+
+        rest.remove_prefix(1);
+        return true;
+    };
+
+    // only iso dates have a dash after the fourth character
+    if (rest.size() >= 10 && rest[4] == '-')
+    {
+        int seconds;
+
+        h = 12;
+        min = 0;
+
+        good = readDateNumber(rest, y, 4, 4) && skip('-')
+            && readDateNumber(rest, mon, 2, 2) && skip('-')
+            && readDateNumber(rest, d, 2, 2);
+
+        // the time, if there is one
+        if (good && !rest.empty())
+            good = (skip('T') || skip(' '))
+                && readDateNumber(rest, h, 2, 2) && skip(':')
+                && readDateNumber(rest, min, 2, 2)
+                && (!skip(':') || readDateNumber(rest, seconds, 2, 2));
+    }
+    // MM DD YYYY HH MM
+    else
+    {
+        int* fields[5] = { &mon, &d, &y, &h, &min };
+
+        good = readDateNumber(rest, mon, 1, 2);
+
+        for (int i = 1; i < 5 && good; i++)
+        {
+            good = skip(' ') || skip('/');
+
+            while (skip(' ') || skip('/'))
+                ;
+
+            good = good && readDateNumber(rest, *fields[i], 1,
+                i == 2 ? 4 : 2);
+        }
+    }
+
+    if (!good || !rest.empty() || mon < 1 || mon > 12 || d < 1
+        || d > TimePoint::daysInMonth(static_cast<Months>(mon), y)
+        || h > 23 || min > 59)
+        throw std::invalid_argument("Not a date and time: "
+            + string(date));
 }
 
 // read the event's info from the console
 void readEventInfo(string& title, int& year, TimePoint::Months& month, int& day, int& hour,
     int& minute, unsigned short& importance, double& bias)
 {
-    string date_elements[5];
     string input = "\n>> ";
     string time;
 
     cout << "Event name" << input;
     getline(cin, title);
 
-    cout << "Due Date\nMM DD YYYY HH MM (military time)" << input;
+    cout << "Due Date\nMM DD YYYY HH MM (military time)"
+        " or YYYY-MM-DD HH:MM" << input;
     getline(cin, time);
 
-    int element = 0;
-    for (size_t i = 0; i < time.size(); i++)
-    {
-        if (time[i] == ' ' || time[i] == '/')
-        {
-            element++;
-        }
-        else
-        {
-            date_elements[element].push_back(time[i]);
-        }
+    int number;
 
-    }
-
-    year = stoi(date_elements[2]);
-    month = static_cast<TimePoint::Months>(stoi(date_elements[0]));
-    day = stoi(date_elements[1]);
-    hour = stoi(date_elements[3]);
-    minute = stoi(date_elements[4]);
+    formatDate(time, year, number, day, hour, minute);
+    month = static_cast<Months>(number);
 
     cout << "Importance of the event (an integer, ideally from 1-3)" << input;
     cin >> importance;
@@ -424,69 +635,59 @@ void readEventInfo(string& title, int& year, TimePoint::Months& month, int& day,
 
 }
 
-// string to month
-Months stom(std::string month)
+// read a due date from a string
+TimePoint parseDueDate(string_view time)
 {
+    int year, month, day, hour, minute;
 
-    if (month == "January")
-        return Months::January;
-    else if (month == "February")
-        return Months::February;
-    else if (month == "March")
-        return Months::March;
-    else if (month == "April")
-        return Months::April;
-    else if (month == "May")
-        return Months::May;
-    else if (month == "June")
-        return Months::June;
-    else if (month == "July")
-        return Months::July;
-    else if (month == "August")
-        return Months::August;
-    else if (month == "September")
-        return Months::September;
-    else if (month == "October")
-        return Months::October;
-    else if (month == "November")
-        return Months::November;
-    else if (month == "December")
-        return Months::December;
-    else
-        throw std::invalid_argument("Not a month passed through string-to-month");
+    formatDate(time, year, month, day, hour, minute);
+
+    return TimePoint(year, static_cast<Months>(month), day, hour, minute);
 }
 
-// month to string
-string mtos(Months month)
+// read a number at the front of a date
+bool readDateNumber(string_view& rest, int& value, size_t least,
+    size_t most)
 {
-    switch (month)
-    {
-    case Months::January:
-        return "January";
-    case Months::February:
-        return "February";
-    case Months::March:
-        return "March";
-    case Months::April:
-        return "April";
-    case Months::May:
-        return "May";
-    case Months::June:
-        return "June";
-    case Months::July:
-        return "July";
-    case Months::August:
-        return "August";
-    case Months::September:
-        return "September";
-    case Months::October:
-        return "October";
-    case Months::November:
-        return "November";
-    case Months::December:
-        return "December";
-    default:
-        return "";
-    }
+    // from_chars would take a minus sign too
+    if (rest.empty() || rest.front() < '0' || rest.front() > '9')
+        return false;
+
+    auto read = std::from_chars(rest.data(), rest.data() + rest.size(),
+        value);
+    size_t digits = static_cast<size_t>(read.ptr - rest.data());
+
+    if (read.ec != std::errc() || digits < least || digits > most)
+        return false;
+
+    rest.remove_prefix(digits);
+
+    return true;
+}
+
+// pack a due date into minutes
+std::int32_t packDueDate(const TimePoint& date)
+{
+    long long minutes = date.toMinutes();
+
+    // about the years -2110 to 6050
+    if (minutes < INT32_MIN || minutes > INT32_MAX)
+        throw std::out_of_range("The due date is too far from now");
+
+    return static_cast<std::int32_t>(minutes);
+}
+
+// read a whole number
+template <typename whole>
+bool readWholeNumber(double value, whole& field)
+{
+    // written so a NaN fails too
+    if (!(value >= static_cast<double>(std::numeric_limits<whole>::min())
+        && value <= static_cast<double>(std::numeric_limits<whole>::max())
+        && value == std::trunc(value)))
+        return false;
+
+    field = static_cast<whole>(value);
 
+    return true;
 }
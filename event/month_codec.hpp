@@ -0,0 +1,129 @@
+#pragma once
+
+
+// includes
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "timepoint.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::string_view;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the name of every month, by its number
+constexpr string_view MONTH_NAMES[13] = { "", "January", "February",
+    "March", "April", "May", "June", "July", "August", "September",
+    "October", "November", "December" };
+
+// how many slots the month hash has
+constexpr size_t MONTH_HASH_SIZE = 32;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: converts a string to month, the whole name or its first three
+//          letters in any case, or the month's number
+// requires: a string
+// returns: a month, throws invalid_argument if it isn't one
+constexpr Months stom(string_view);
+
+// purpose: converts a month to a string
+// requires: a month
+// returns: its name, empty if it isn't a month
+constexpr string_view mtos(Months month);
+
+
+    /**************\
+    *  month hash  *
+    \**************/
+
+// the month in each slot of the hash, 0 for none, filled in when this is
+// compiled
+constexpr struct MonthHashTable
+{
+    int months[MONTH_HASH_SIZE];
+    // whether every month got a slot of its own
+    bool perfect;
+
+    constexpr MonthHashTable() : months(), perfect(true)
+    {
+        for (int i = 1; i <= 12; i++)
+        {
+            size_t at = slot(MONTH_NAMES[i]);
+
+            perfect = perfect && months[at] == 0;
+            months[at] = i;
+        }
+    }
+
+    // purpose: hashes the first three letters of a month's name, in any
+    //          case, into a slot of its own
+    // requires: at least three characters
+    // returns: the slot
+    static constexpr size_t slot(string_view name)
+    {
+        // setting 0x20 makes letters lower case, which is all it sees
+        return (4 * static_cast<size_t>(name[0] | 0x20)
+            + static_cast<size_t>(name[1] | 0x20)
+            + static_cast<size_t>(name[2] | 0x20)) % MONTH_HASH_SIZE;
+    }
+} MONTH_HASH;
+
+static_assert(MONTH_HASH.perfect, "every month needs a slot of its own");
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// string to month
+constexpr Months stom(string_view month)
+{
+    // a number, with or without a leading zero
+    if (!month.empty() && month.size() <= 2 && month[0] >= '0'
+        && month[0] <= '9' && month.back() >= '0' && month.back() <= '9')
+    {
+        int number = month.size() == 1 ? month[0] - '0'
+            : (month[0] - '0') * 10 + month[1] - '0';
+
+        if (number >= Months::January && number <= Months::December)
+            return static_cast<Months>(number);
+    }
+    else if (month.size() >= 3)
+    {
+        int found = MONTH_HASH.months[MONTH_HASH.slot(month)];
+        string_view name = MONTH_NAMES[found];
+        bool same = found != 0
+            && (month.size() == 3 || month.size() == name.size());
+
+        // the hash only picks the month, the letters still have to match
+        for (size_t i = 0; same && i < month.size(); i++)
+            same = (month[i] | 0x20) == (name[i] | 0x20);
+
+        if (same)
+            return static_cast<Months>(found);
+    }
+
+    throw std::invalid_argument("Not a month passed through string-to-month");
+}
+
+// month to string
+constexpr string_view mtos(Months month)
+{
+    if (month < Months::January || month > Months::December)
+        return string_view();
+
+    return MONTH_NAMES[month];
+}
@@ -0,0 +1,517 @@
+#pragma once
+
+
+// includes
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include "time_zone.hpp"
+#include "timepoint.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// a schedule in use, 0 being a due date that floats and doesn't repeat
+using ScheduleId = std::uint16_t;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the most a formatted recurrence rule can take up
+constexpr size_t RECURRENCE_TEXT_SIZE = 96;
+
+// the two letters of each day of the week, Sunday first
+constexpr string_view WEEKDAY_CODES[7] = { "SU", "MO", "TU", "WE", "TH",
+    "FR", "SA" };
+
+// the frequencies, by their number
+constexpr string_view FREQUENCY_NAMES[5] = { "", "DAILY", "WEEKLY",
+    "MONTHLY", "YEARLY" };
+
+
+    /**************\
+    *  Recurrence  *
+    \**************/
+
+// how often an event comes back
+enum class Frequency : std::uint8_t
+{
+    None, Daily, Weekly, Monthly, Yearly
+};
+
+// a rule for an event that repeats, the part of an iCalendar RRULE a to
+// do list needs: FREQ, INTERVAL, BYDAY for the nth weekday of the month,
+// BYMONTHDAY, and UNTIL
+// it's only the rule, the event's due date is its next occurrence, so a
+// rule costs the same however many times it comes back
+struct Recurrence
+{
+    Frequency frequency = Frequency::None;
+    // every how many days, weeks, months, or years
+    std::uint16_t interval = 1;
+    // the nth weekday of the month, 1 to 4 or -1 for the last one, 0 to
+    // go by the day of the month
+    std::int8_t week = 0;
+    // 0 for Sunday
+    std::uint8_t weekday = 0;
+    // the day of the month it's on, so the 31st comes back on the 31st
+    // after a shorter month, 0 for the due date's
+    std::uint8_t monthDay = 0;
+    // the last time it can be due, in minutes since 1970
+    std::int32_t until = INT32_MAX;
+};
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: finds out if two rules are the same
+// requires: two rules
+// returns: a boolean
+bool operator==(const Recurrence&, const Recurrence&);
+
+// purpose: reads a recurrence rule, one of daily, weekly, monthly, and
+//          yearly, or an RRULE like "FREQ=MONTHLY;INTERVAL=2;BYDAY=-1FR;
+//          UNTIL=20271231" ("RRULE:" in front is allowed), UNTIL can have
+//          a THHMM or THHMMSS time, and without one it's the end of the day
+// requires: the text and a rule to fill in
+// returns: false if it isn't one, and then the rule is left as it was
+bool readRecurrence(string_view, Recurrence&);
+
+// purpose: reads a recurrence rule the way readRecurrence does
+// requires: the text
+// returns: the rule, throws invalid_argument if it isn't one
+Recurrence parseRecurrence(string_view);
+
+// purpose: writes a rule as an RRULE, without the "RRULE:"
+// requires: a buffer of RECURRENCE_TEXT_SIZE and the rule
+// returns: the end of what was written
+char* formatRecurrence(char*, const Recurrence&);
+
+// purpose: finds the occurrence after a due date, in the due date's own
+//          local time, so 0900 stays 0900 across a change of offset
+// requires: the rule and the due date in minutes since 1970, which is
+//           moved to the next occurrence
+// returns: false if the rule doesn't repeat or has run out
+bool nextOccurrence(const Recurrence&, long long&);
+
+
+    /************\
+    *  Schedule  *
+    \************/
+
+// when an event's due date happens: the time zone it's in and how it
+// repeats, kept in a table so the event only carries a small id
+struct Schedule
+{
+    ZoneId zone = 0;
+    Recurrence repeat;
+};
+
+// purpose: finds out if two schedules are the same
+// requires: two schedules
+// returns: a boolean
+bool operator==(const Schedule&, const Schedule&);
+
+// hashes every field of a schedule
+struct ScheduleHash
+{
+    size_t operator()(const Schedule&) const;
+};
+
+
+    /*****************\
+    *  ScheduleTable  *
+    \*****************/
+
+// stores each distinct schedule once and hands out a number for it, most
+// lists only have a handful (weekly, monthly, a couple of zones)
+// like the titles, it's only used by whoever owns the list
+class ScheduleTable
+{
+public:
+
+    ScheduleTable() { reset(); }
+
+    // purpose: gets the id of a schedule, adding it if it's new
+    // requires: the schedule
+    // returns: its id, throws length_error if there are too many
+    ScheduleId intern(const Schedule&);
+
+    // purpose: gets a schedule
+    // requires: an id from this table
+    // returns: the schedule
+    const Schedule& get(ScheduleId id) const { return schedules[id]; }
+
+    // purpose: gets the number of distinct schedules
+    // requires: nothing
+    // returns: the size
+    size_t size() const { return schedules.size(); }
+
+    // purpose: forgets every schedule, for when the list is reloaded
+    //          the blank schedule is always 0
+    // requires: nothing
+    // returns: nothing
+    void reset();
+
+private:
+
+    vector<Schedule> schedules;
+    std::unordered_map<Schedule, ScheduleId, ScheduleHash> ids;
+};
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the schedules of the list
+ScheduleTable SCHEDULES;
+
+
+    /*************************\
+    *  ScheduleTable methods  *
+    \*************************/
+
+// intern a schedule
+ScheduleId ScheduleTable::intern(const Schedule& schedule)
+{
+    auto found = ids.find(schedule);
+
+    if (found != ids.end())
+        return found->second;
+
+    if (schedules.size() > UINT16_MAX)
+        throw std::length_error("Too many different schedules in the list");
+
+    ScheduleId id = static_cast<ScheduleId>(schedules.size());
+
+    schedules.push_back(schedule);
+    ids.emplace(schedule, id);
+
+    return id;
+}
+
+// forget everything
+void ScheduleTable::reset()
+{
+    schedules.clear();
+    ids.clear();
+
+    schedules.push_back(Schedule());
+    ids.emplace(Schedule(), 0);
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// compare rules
+bool operator==(const Recurrence& a, const Recurrence& b)
+{
+    return a.frequency == b.frequency && a.interval == b.interval
+        && a.week == b.week && a.weekday == b.weekday
+        && a.monthDay == b.monthDay && a.until == b.until;
+}
+
+// compare schedules
+bool operator==(const Schedule& a, const Schedule& b)
+{
+    return a.zone == b.zone && a.repeat == b.repeat;
+}
+
+// hash a schedule
+size_t ScheduleHash::operator()(const Schedule& schedule) const
+{
+    const Recurrence& repeat = schedule.repeat;
+    std::uint64_t fields = schedule.zone
+        | static_cast<std::uint64_t>(repeat.frequency) << 16
+        | static_cast<std::uint64_t>(repeat.interval) << 24
+        | static_cast<std::uint64_t>(static_cast<std::uint8_t>(
+            repeat.week)) << 40
+        | static_cast<std::uint64_t>(repeat.weekday) << 48
+        | static_cast<std::uint64_t>(repeat.monthDay) << 56;
+
+    return static_cast<size_t>((fields ^ static_cast<std::uint32_t>(
+        repeat.until)) * 0x9E3779B97F4A7C15ULL);
+}
+
+// read a recurrence rule
+bool readRecurrence(string_view text, Recurrence& result)
+{
+    // the result is only filled in once the whole rule has been read
+    Recurrence rule;
+
+    // the plain words are the rules people want most
+    for (int i = 1; i <= 4; i++)
+    {
+        string_view name = FREQUENCY_NAMES[i];
+        bool same = text.size() == name.size();
+
+        for (size_t j = 0; same && j < text.size(); j++)
+            same = (text[j] & ~0x20) == name[j];
+
+        if (same)
+        {
+            rule.frequency = static_cast<Frequency>(i);
+            result = rule;
+            return true;
+        }
+    }
+
+    if (text.compare(0, 6, "RRULE:") == 0)
+        text.remove_prefix(6);
+
+    while (!text.empty())
+    {
+        size_t end = text.find(';');
+        string_view part = text.substr(0, end);
+        size_t equals = part.find('=');
+        string_view name = part.substr(0, equals);
+        string_view value = equals == string_view::npos ? string_view()
+            : part.substr(equals + 1);
+        const char* last = value.data() + value.size();
+        int number = 0;
+
+        text.remove_prefix(end == string_view::npos ? text.size() : end + 1);
+
+        if (name == "FREQ")
+        {
+            for (int i = 1; i <= 4; i++)
+                if (value == FREQUENCY_NAMES[i])
+                    rule.frequency = static_cast<Frequency>(i);
+        }
+        else if (name == "INTERVAL")
+        {
+            auto read = std::from_chars(value.data(), last, number);
+
+            if (read.ec != std::errc() || read.ptr != last || number < 1
+                || number > UINT16_MAX)
+                return false;
+
+            rule.interval = static_cast<std::uint16_t>(number);
+        }
+        else if (name == "BYDAY")
+        {
+            // a week number, with a sign for counting from the end, and
+            // then the day
+            if (value.size() < 3)
+                return false;
+
+            string_view day = value.substr(value.size() - 2);
+            const char* digits = value.data() + (value[0] == '+' ? 1 : 0);
+            auto read = std::from_chars(digits, last - 2, number);
+
+            if (read.ec != std::errc() || read.ptr != last - 2
+                || (number != -1 && (number < 1 || number > 4)))
+                return false;
+
+            rule.week = static_cast<std::int8_t>(number);
+            rule.weekday = 7;
+            for (int i = 0; i < 7; i++)
+                if (day == WEEKDAY_CODES[i])
+                    rule.weekday = static_cast<std::uint8_t>(i);
+
+            if (rule.weekday == 7)
+                return false;
+        }
+        else if (name == "BYMONTHDAY")
+        {
+            auto read = std::from_chars(value.data(), last, number);
+
+            if (read.ec != std::errc() || read.ptr != last || number < 1
+                || number > 31)
+                return false;
+
+            rule.monthDay = static_cast<std::uint8_t>(number);
+        }
+        else if (name == "UNTIL")
+        {
+            // YYYYMMDD, then THHMM and maybe SS, and maybe a Z that's
+            // taken as the due date's own time
+            int fields[6] = { 0, 0, 0, 23, 59, 0 };
+            size_t widths[6] = { 4, 2, 2, 2, 2, 2 };
+            size_t at = 0;
+
+            if (!value.empty() && value.back() == 'Z')
+                value.remove_suffix(1);
+
+            for (int i = 0; i < 6 && at < value.size(); i++)
+            {
+                if (i == 3 && value[at++] != 'T')
+                    return false;
+
+                auto read = std::from_chars(value.data() + at,
+                    value.data() + std::min(at + widths[i], value.size()),
+                    fields[i]);
+
+                if (read.ec != std::errc()
+                    || read.ptr != value.data() + at + widths[i])
+                    return false;
+
+                at += widths[i];
+            }
+
+            if ((at != 8 && at != 13 && at != 15) || fields[1] < 1
+                || fields[1] > 12 || fields[2] < 1 || fields[2]
+                > TimePoint::daysInMonth(static_cast<Months>(fields[1]),
+                    fields[0]) || fields[3] > 23 || fields[4] > 59)
+                return false;
+
+            long long minutes = TimePoint(fields[0],
+                static_cast<Months>(fields[1]), fields[2], fields[3],
+                fields[4]).toMinutes();
+
+            rule.until = static_cast<std::int32_t>(std::min<long long>(
+                std::max<long long>(minutes, INT32_MIN), INT32_MAX));
+        }
+        else
+            return false;
+    }
+
+    // the nth weekday and day of the month only go with months and years
+    if (rule.frequency == Frequency::None || ((rule.week != 0
+        || rule.monthDay != 0) && rule.frequency != Frequency::Monthly
+        && rule.frequency != Frequency::Yearly))
+        return false;
+
+    result = rule;
+
+    return true;
+}
+
+// read a recurrence rule or throw
+Recurrence parseRecurrence(string_view text)
+{
+    Recurrence rule;
+
+    if (!readRecurrence(text, rule))
+        throw std::invalid_argument("Not a recurrence rule: "
+            + string(text));
+
+    return rule;
+}
+
+// write a rule
+char* formatRecurrence(char* out, const Recurrence& rule)
+{
+    auto append = [&out](string_view text)
+    {
+        text.copy(out, text.size());
+        out += text.size();
+    };
+    auto number = [&out](int value)
+    {
+        out = std::to_chars(out, out + INT_TEXT_SIZE, value).ptr;
+    };
+
+    append("FREQ=");
+    append(FREQUENCY_NAMES[static_cast<int>(rule.frequency)]);
+
+    if (rule.interval != 1)
+    {
+        append(";INTERVAL=");
+        number(rule.interval);
+    }
+
+    if (rule.week != 0)
+    {
+        append(";BYDAY=");
+        number(rule.week);
+        append(WEEKDAY_CODES[rule.weekday % 7]);
+    }
+
+    if (rule.monthDay != 0)
+    {
+        append(";BYMONTHDAY=");
+        number(rule.monthDay);
+    }
+
+    if (rule.until != INT32_MAX)
+    {
+        TimePoint until = TimePoint::fromMinutes(rule.until);
+
+        // the ISO form, without its dashes and colon, is the RRULE form
+        char text[TIME_POINT_TEXT_SIZE];
+        char* end = until.formatISO(text);
+
+        append(";UNTIL=");
+        for (char* i = text; i != end; i++)
+            if (*i != '-' && *i != ':')
+                *out++ = *i;
+        append("00");
+    }
+
+    return out;
+}
+
+// find the next occurrence
+bool nextOccurrence(const Recurrence& rule, long long& due)
+{
+    long long next = due;
+
+    switch (rule.frequency)
+    {
+    case Frequency::Daily:
+        next += 1440LL * rule.interval;
+        break;
+    case Frequency::Weekly:
+        next += 7 * 1440LL * rule.interval;
+        break;
+    case Frequency::Monthly:
+    case Frequency::Yearly:
+    {
+        TimePoint point = TimePoint::fromMinutes(due);
+        long long months = static_cast<long long>(point.year) * 12
+            + point.month - 1 + static_cast<long long>(rule.interval)
+            * (rule.frequency == Frequency::Yearly ? 12 : 1);
+        int year = static_cast<int>(months / 12);
+        Months month = static_cast<Months>(months % 12 + 1);
+        int day = rule.monthDay != 0 ? rule.monthDay : point.day;
+        long long time = point.hour * 60 + point.minute;
+
+        if (rule.week != 0)
+        {
+            // the same nth weekday a POSIX TZ rule changes over on, where
+            // week 5 is the last
+            RuleDate date{ 'M', month, rule.week < 0 ? 5 : rule.week,
+                rule.weekday, 0 };
+
+            next = ruleDateSeconds(date, year) / 60 + time;
+            break;
+        }
+
+        // a day past the end of a shorter month is its last day
+        day = std::min(day, TimePoint::daysInMonth(month, year));
+        next = TimePoint(year, month, day, 0, 0).toMinutes() + time;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    if (next > rule.until)
+        return false;
+
+    due = next;
+
+    return true;
+}
@@ -0,0 +1,784 @@
+#pragma once
+
+
+// includes
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "timepoint.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+// a time zone in use, 0 being none (a floating time, in whatever zone the
+// clock is in)
+using ZoneId = std::uint16_t;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// where the zone files are when TZDIR doesn't say
+constexpr const char* ZONE_INFO_DIR = "/usr/share/zoneinfo";
+
+// the rule at the end of a zone file is worked out into transitions up to
+// this year, so every conversion is a lookup in one table (after it the
+// last offset holds)
+constexpr int ZONE_RULES_LAST_YEAR = 2200;
+
+// the most zones that can be in use at once
+constexpr size_t ZONE_LIMIT = 1024;
+
+
+    /*****************\
+    *  POSIX TZ rule  *
+    \*****************/
+
+// the day a daylight saving rule changes over on, as a POSIX TZ string
+// has it: Jn (1-365, never counting February 29th), n (0-365), or
+// Mm.w.d (day d of week w of month m, week 5 being the last)
+struct RuleDate
+{
+    char kind;
+    int month;
+    int week;
+    int day;
+    // seconds after local midnight, can be negative or past a day
+    int time;
+};
+
+// the zone a POSIX TZ string describes
+struct PosixRule
+{
+    // seconds east of UTC
+    int standard;
+    int daylight;
+    bool hasDaylight;
+    RuleDate start;
+    RuleDate end;
+};
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: reads a POSIX TZ string, like "EST5EDT,M3.2.0,M11.1.0"
+// requires: the string and a rule to fill in
+// returns: false if it isn't one
+bool readPosixRule(string_view, PosixRule&);
+
+// purpose: reads a zone abbreviation off the front of a TZ string,
+//          letters or anything between < and >
+// requires: the rest of the string
+// returns: false if there isn't one
+bool readZoneAbbreviation(string_view&);
+
+// purpose: reads [+-]hh[:mm[:ss]] off the front of a TZ string
+// requires: the rest of the string and where to put the seconds
+// returns: false if there isn't one
+bool readZoneTime(string_view&, int&);
+
+// purpose: reads ",date[/time]" off the front of a TZ string
+// requires: the rest of the string and the date to fill in
+// returns: false if there isn't one
+bool readRuleDate(string_view&, RuleDate&);
+
+// purpose: finds when a rule changes over in a year
+// requires: the date of the change and the year
+// returns: seconds since 1970 of the change in the local time it
+//          happens in, that time's offset still has to come off
+long long ruleDateSeconds(const RuleDate&, int year);
+
+// purpose: rounds seconds down to a minute, offsets from before time
+//          zones were standard can have seconds in them
+// requires: seconds since 1970
+// returns: the minute they fall in
+long long floorMinutes(long long);
+
+// purpose: reads a big-endian number out of a zone file
+// requires: where it starts and how many bytes it has (4 or 8)
+// returns: the number
+long long readBigEndian(const unsigned char*, int bytes);
+
+
+    /************\
+    *  TimeZone  *
+    \************/
+
+// the rules of a time zone, read once out of the system's zone files and
+// kept as one table of every change of offset, so converting a time
+// either way is a binary search
+class TimeZone
+{
+public:
+
+    // purpose: makes a floating zone that converts nothing
+    // requires: the name it goes by
+    // returns: nothing
+    explicit TimeZone(string_view zoneName) : label(zoneName) { }
+
+    // purpose: reads the zone's rules out of a TZif file
+    // requires: the path of the file
+    // returns: false if it isn't there or isn't a zone file, and then the
+    //          zone stays floating
+    bool load(const string&);
+
+    // purpose: takes the zone's rules from a POSIX TZ string alone
+    // requires: the string
+    // returns: false if it isn't one
+    bool loadRule(string_view);
+
+    // purpose: determines if the zone has rules, a zone that doesn't
+    //          converts nothing
+    // requires: nothing
+    // returns: true if it does
+    bool isLoaded() const { return loaded; }
+
+    // purpose: gets the name the zone goes by
+    // requires: nothing
+    // returns: the name
+    string_view name() const { return label; }
+
+    // purpose: finds the offset from UTC at an instant
+    // requires: seconds since 1970 UTC
+    // returns: seconds east of UTC
+    int offsetAt(long long) const;
+
+    // purpose: converts a time in UTC to the zone's local time
+    // requires: minutes since 1970 UTC
+    // returns: the local minutes since 1970
+    long long toLocal(long long) const;
+
+    // purpose: converts the zone's local time to UTC, a time skipped by a
+    //          change is moved forward across the gap, and a time that
+    //          happens twice is taken the first time
+    // requires: the local minutes since 1970
+    // returns: minutes since 1970 UTC
+    long long toUTC(long long) const;
+
+private:
+
+    string label;
+    bool loaded = false;
+    // the offset before the first transition
+    int initial = 0;
+    // when the offset changes, in seconds since 1970 UTC, and what it
+    // changes to
+    vector<long long> transitions;
+    vector<int> offsets;
+
+    // purpose: adds the transitions a rule makes, from the year of the
+    //          last one there already is up to ZONE_RULES_LAST_YEAR
+    // requires: the rule
+    // returns: nothing
+    void extend(const PosixRule&);
+};
+
+
+    /*************\
+    *  ZoneTable  *
+    \*************/
+
+// every zone in use, each read the first time it's asked for and kept,
+// so events only carry a small id
+class ZoneTable
+{
+public:
+
+    ZoneTable();
+
+    // purpose: finds a zone by name, reading its file the first time,
+    //          a name without a zone file isn't kept, so names that
+    //          aren't zones can't fill the table
+    // requires: the name, like "Europe/Paris"
+    // returns: its id, 0 for an empty name or one that isn't a zone,
+    //          throws length_error if there are too many zones
+    ZoneId find(string_view);
+
+    // purpose: finds the zone the system's clock is in, from TZ or else
+    //          /etc/localtime, the first time it's asked for
+    // requires: nothing
+    // returns: its id, 0 if it can't be found
+    ZoneId local();
+
+    // purpose: gets a zone
+    // requires: its id, which find or local handed out
+    // returns: the zone
+    const TimeZone& zone(ZoneId id) const { return zones[id]; }
+
+    // purpose: converts local minutes from one zone to another, through
+    //          UTC, a floating zone is taken as the system's
+    // requires: the minutes, and the zones they're from and to
+    // returns: the minutes in the other zone
+    long long convert(long long, ZoneId from, ZoneId to);
+
+private:
+
+    std::mutex lock;
+    // reserved up front, so the zones never move while they're read
+    vector<TimeZone> zones;
+    std::atomic<int> localId{ -1 };
+
+    // purpose: adds a zone, the lock has to be held
+    // requires: the zone, loaded
+    // returns: its id
+    ZoneId add(TimeZone);
+};
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the zones in use
+ZoneTable ZONES;
+
+
+    /********************\
+    *  TimeZone methods  *
+    \********************/
+
+// read a zone file
+bool TimeZone::load(const string& path)
+{
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)),
+        std::istreambuf_iterator<char>());
+    const size_t header = 44;
+
+    if (bytes.size() < header || string_view(reinterpret_cast<const char*>(
+        bytes.data()), 4) != "TZif")
+        return false;
+
+    // version 1 has 32-bit times, 2 and up repeat everything with 64-bit
+    // ones after it and end with a POSIX TZ string
+    bool wide = bytes[4] >= '2';
+    size_t at = 0;
+    int timeSize = 4;
+
+    for (int pass = 0; pass < (wide ? 2 : 1); pass++)
+    {
+        if (bytes.size() < at + header)
+            return false;
+
+        const unsigned char* counts = bytes.data() + at + 20;
+        size_t utCount = static_cast<size_t>(readBigEndian(counts, 4));
+        size_t stdCount = static_cast<size_t>(readBigEndian(counts + 4, 4));
+        size_t leapCount = static_cast<size_t>(readBigEndian(counts + 8, 4));
+        size_t timeCount = static_cast<size_t>(readBigEndian(counts + 12, 4));
+        size_t typeCount = static_cast<size_t>(readBigEndian(counts + 16, 4));
+        size_t charCount = static_cast<size_t>(readBigEndian(counts + 20, 4));
+        size_t size = timeCount * timeSize + timeCount + typeCount * 6
+            + charCount + leapCount * (timeSize + 4) + stdCount + utCount;
+
+        if (typeCount == 0 || bytes.size() < at + header + size)
+            return false;
+
+        // the first pass is only skipped over when there's a second one
+        if (wide && pass == 0)
+        {
+            at += header + size;
+            timeSize = 8;
+            continue;
+        }
+
+        const unsigned char* times = bytes.data() + at + header;
+        const unsigned char* indices = times + timeCount * timeSize;
+        const unsigned char* types = indices + timeCount;
+
+        transitions.clear();
+        offsets.clear();
+
+        // times before the first transition are in the first type
+        initial = static_cast<int>(readBigEndian(types, 4));
+
+        for (size_t i = 0; i < timeCount; i++)
+        {
+            if (indices[i] >= typeCount)
+                return false;
+
+            transitions.push_back(readBigEndian(times + i * timeSize,
+                timeSize));
+            offsets.push_back(static_cast<int>(readBigEndian(
+                types + indices[i] * 6, 4)));
+        }
+
+        at += header + size;
+    }
+
+    // the footer's rule covers everything after the last transition
+    if (wide && at < bytes.size() && bytes[at] == '\n')
+    {
+        auto first = bytes.begin() + at + 1;
+        auto last = std::find(first, bytes.end(), '\n');
+        PosixRule rule;
+
+        if (first != last && readPosixRule(string_view(
+            reinterpret_cast<const char*>(&*first), last - first), rule))
+        {
+            if (transitions.empty())
+                initial = rule.standard;
+            extend(rule);
+        }
+    }
+
+    loaded = true;
+
+    return true;
+}
+
+// take the rules from a TZ string
+bool TimeZone::loadRule(string_view text)
+{
+    PosixRule rule;
+
+    if (!readPosixRule(text, rule))
+        return false;
+
+    transitions.clear();
+    offsets.clear();
+    initial = rule.standard;
+    extend(rule);
+    loaded = true;
+
+    return true;
+}
+
+// find the offset at an instant
+int TimeZone::offsetAt(long long seconds) const
+{
+    auto after = std::upper_bound(transitions.begin(), transitions.end(),
+        seconds);
+
+    if (after == transitions.begin())
+        return initial;
+
+    return offsets[after - transitions.begin() - 1];
+}
+
+// convert from utc
+long long TimeZone::toLocal(long long minutes) const
+{
+    if (!loaded)
+        return minutes;
+
+    return floorMinutes(minutes * 60 + offsetAt(minutes * 60));
+}
+
+// convert to utc
+long long TimeZone::toUTC(long long minutes) const
+{
+    if (!loaded)
+        return minutes;
+
+    // the offsets a day either side of the time, one of them is right
+    // unless two changes are less than a day apart
+    long long local = minutes * 60;
+    int before = offsetAt(local - 86400);
+    int after = offsetAt(local + 86400);
+
+    // rounding up keeps an offset with seconds in it converting back to
+    // the same minute
+    if (offsetAt(local - before) == before)
+        return floorMinutes(local - before + 59);
+    if (offsetAt(local - after) == after)
+        return floorMinutes(local - after + 59);
+
+    // in a gap, the offset from before it moves the time past it
+    return floorMinutes(local - before + 59);
+}
+
+// work a rule out into transitions
+void TimeZone::extend(const PosixRule& rule)
+{
+    // a zone that stopped changing stays on the last offset it has
+    if (!rule.hasDaylight)
+        return;
+
+    int year = transitions.empty() ? 1970
+        : TimePoint::fromMinutes(transitions.back() / 60).year;
+
+    for (; year <= ZONE_RULES_LAST_YEAR; year++)
+    {
+        // daylight saving starts in standard time and ends in daylight
+        long long start = ruleDateSeconds(rule.start, year) - rule.standard;
+        long long end = ruleDateSeconds(rule.end, year) - rule.daylight;
+        long long times[2] = { start, end };
+        int changes[2] = { rule.daylight, rule.standard };
+
+        // south of the equator it ends before it starts
+        if (end < start)
+        {
+            std::swap(times[0], times[1]);
+            std::swap(changes[0], changes[1]);
+        }
+
+        // before the first change it's whatever that change ends
+        if (transitions.empty())
+            initial = changes[1];
+
+        for (int i = 0; i < 2; i++)
+        {
+            if (!transitions.empty() && times[i] <= transitions.back())
+                continue;
+
+            transitions.push_back(times[i]);
+            offsets.push_back(changes[i]);
+        }
+    }
+}
+
+
+    /*********************\
+    *  ZoneTable methods  *
+    \*********************/
+
+// start with the floating zone
+ZoneTable::ZoneTable()
+{
+    zones.reserve(ZONE_LIMIT);
+    zones.emplace_back("");
+}
+
+// find a zone by name
+ZoneId ZoneTable::find(string_view name)
+{
+    if (name.empty())
+        return 0;
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    for (size_t i = 1; i < zones.size(); i++)
+        if (zones[i].name() == name)
+            return static_cast<ZoneId>(i);
+
+    const char* directory = std::getenv("TZDIR");
+    TimeZone zone(name);
+
+    // names can't climb out of the zone directory
+    if (name.find("..") != string_view::npos || name.front() == '/')
+        return 0;
+
+    if (!zone.load(string(directory != nullptr && *directory != '\0'
+        ? directory : ZONE_INFO_DIR) + "/" + string(name)))
+        return 0;
+
+    return add(std::move(zone));
+}
+
+// find the system's zone
+ZoneId ZoneTable::local()
+{
+    int known = localId.load(std::memory_order_acquire);
+
+    if (known >= 0)
+        return static_cast<ZoneId>(known);
+
+    const char* tz = std::getenv("TZ");
+    string_view setting = tz != nullptr ? tz : "";
+    ZoneId id = 0;
+
+    if (!setting.empty() && setting.front() == ':')
+        setting.remove_prefix(1);
+
+    if (!setting.empty())
+    {
+        id = find(setting);
+
+        // TZ can also be a rule of its own
+        if (id == 0)
+        {
+            TimeZone rule(setting);
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (rule.loadRule(setting))
+                id = add(std::move(rule));
+        }
+    }
+    else
+    {
+        // /etc/localtime is usually a link into the zone directory, which
+        // gives the zone its proper name
+        std::error_code error;
+        string target = std::filesystem::read_symlink("/etc/localtime",
+            error).generic_string();
+        size_t named = target.find("zoneinfo/");
+
+        if (!error && named != string::npos)
+            id = find(string_view(target).substr(named + 9));
+
+        if (id == 0)
+        {
+            TimeZone system("localtime");
+            std::lock_guard<std::mutex> guard(lock);
+
+            if (system.load("/etc/localtime"))
+                id = add(std::move(system));
+        }
+    }
+
+    localId.store(id, std::memory_order_release);
+
+    return id;
+}
+
+// convert between zones
+long long ZoneTable::convert(long long minutes, ZoneId from, ZoneId to)
+{
+    ZoneId system = 0;
+
+    if (from == to)
+        return minutes;
+
+    // a floating time is in the system's zone
+    if (from == 0 || to == 0)
+        system = local();
+
+    const TimeZone& source = zones[from == 0 ? system : from];
+    const TimeZone& target = zones[to == 0 ? system : to];
+
+    return target.toLocal(source.toUTC(minutes));
+}
+
+// add a zone
+ZoneId ZoneTable::add(TimeZone zone)
+{
+    if (zones.size() >= ZONE_LIMIT)
+        throw std::length_error("Too many time zones in use");
+
+    zones.push_back(std::move(zone));
+
+    return static_cast<ZoneId>(zones.size() - 1);
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// read a TZ string
+bool readPosixRule(string_view text, PosixRule& rule)
+{
+    int west;
+
+    // the offsets in a TZ string are west of UTC, the other way round
+    // from everywhere else
+    if (!readZoneAbbreviation(text) || !readZoneTime(text, west))
+        return false;
+
+    rule.standard = -west;
+    rule.hasDaylight = !text.empty();
+
+    if (!rule.hasDaylight)
+        return true;
+
+    if (!readZoneAbbreviation(text))
+        return false;
+
+    rule.daylight = rule.standard + 3600;
+    if (!text.empty() && text.front() != ',')
+    {
+        if (!readZoneTime(text, west))
+            return false;
+        rule.daylight = -west;
+    }
+
+    // without dates daylight saving goes by the US rules
+    if (text.empty())
+        text = ",M3.2.0,M11.1.0";
+
+    return readRuleDate(text, rule.start) && readRuleDate(text, rule.end)
+        && text.empty();
+}
+
+// read a zone abbreviation
+bool readZoneAbbreviation(string_view& text)
+{
+    size_t length = 0;
+
+    if (!text.empty() && text.front() == '<')
+    {
+        length = text.find('>');
+
+        if (length == string_view::npos)
+            return false;
+
+        text.remove_prefix(length + 1);
+        return length > 1;
+    }
+
+    while (length < text.size() && ((text[length] | 0x20) >= 'a'
+        && (text[length] | 0x20) <= 'z'))
+        length++;
+
+    text.remove_prefix(length);
+
+    return length >= 3;
+}
+
+// read a time or offset
+bool readZoneTime(string_view& text, int& seconds)
+{
+    int sign = 1;
+    int parts[3] = { 0, 0, 0 };
+
+    if (!text.empty() && (text.front() == '+' || text.front() == '-'))
+    {
+        sign = text.front() == '-' ? -1 : 1;
+        text.remove_prefix(1);
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        size_t digits = 0;
+
+        if (i > 0)
+        {
+            if (text.empty() || text.front() != ':')
+                break;
+            text.remove_prefix(1);
+        }
+
+        while (digits < text.size() && digits < 3 && text[digits] >= '0'
+            && text[digits] <= '9')
+            parts[i] = parts[i] * 10 + text[digits++] - '0';
+
+        if (digits == 0)
+            return false;
+
+        text.remove_prefix(digits);
+    }
+
+    seconds = sign * (parts[0] * 3600 + parts[1] * 60 + parts[2]);
+
+    return true;
+}
+
+// read when a rule changes over
+bool readRuleDate(string_view& text, RuleDate& date)
+{
+    int numbers[3] = { 0, 0, 0 };
+    int count = 0;
+
+    if (text.empty() || text.front() != ',')
+        return false;
+
+    text.remove_prefix(1);
+    date.kind = 'n';
+    if (!text.empty() && (text.front() == 'J' || text.front() == 'M'))
+    {
+        date.kind = text.front();
+        text.remove_prefix(1);
+    }
+
+    // Mm.w.d has three numbers, the others one
+    for (; count < (date.kind == 'M' ? 3 : 1); count++)
+    {
+        size_t digits = 0;
+
+        if (count > 0)
+        {
+            if (text.empty() || text.front() != '.')
+                return false;
+            text.remove_prefix(1);
+        }
+
+        while (digits < text.size() && digits < 3 && text[digits] >= '0'
+            && text[digits] <= '9')
+            numbers[count] = numbers[count] * 10 + text[digits++] - '0';
+
+        if (digits == 0)
+            return false;
+
+        text.remove_prefix(digits);
+    }
+
+    date.month = numbers[0];
+    date.week = numbers[1];
+    date.day = date.kind == 'M' ? numbers[2] : numbers[0];
+    date.time = 2 * 3600;
+
+    if ((date.kind == 'M' && (date.month < 1 || date.month > 12
+        || date.week < 1 || date.week > 5 || date.day > 6))
+        || (date.kind == 'J' && (date.day < 1 || date.day > 365))
+        || (date.kind == 'n' && date.day > 365))
+        return false;
+
+    if (!text.empty() && text.front() == '/')
+    {
+        text.remove_prefix(1);
+        return readZoneTime(text, date.time);
+    }
+
+    return true;
+}
+
+// find when a rule changes over
+long long ruleDateSeconds(const RuleDate& date, int year)
+{
+    long long days = TimePoint(year, Months::January, 1, 0, 0).toMinutes()
+        / 1440;
+
+    if (date.kind == 'J')
+        // February 29th doesn't count
+        days += date.day - 1
+            + (TimePoint::isLeapYear(year) && date.day >= 60 ? 1 : 0);
+    else if (date.kind == 'n')
+        days += date.day;
+    else
+    {
+        Months month = static_cast<Months>(date.month);
+        long long first = TimePoint(year, month, 1, 0, 0).toMinutes() / 1440;
+        // 1970/01/01 was a Thursday, day 4
+        int weekday = static_cast<int>(((first + 4) % 7 + 7) % 7);
+        int day = 1 + (date.day - weekday + 7) % 7 + (date.week - 1) * 7;
+
+        // week 5 is the last one, whether the month has 4 or 5
+        while (day > TimePoint::daysInMonth(month, year))
+            day -= 7;
+
+        days = first + day - 1;
+    }
+
+    return days * 86400 + date.time;
+}
+
+// round down to a minute
+long long floorMinutes(long long seconds)
+{
+    return seconds >= 0 ? seconds / 60 : (seconds - 59) / 60;
+}
+
+// read a big-endian number
+long long readBigEndian(const unsigned char* bytes, int size)
+{
+    std::uint64_t value = 0;
+
+    for (int i = 0; i < size; i++)
+        value = (value << 8) | bytes[i];
+
+    // sign extend the 32-bit ones
+    if (size == 4)
+        return static_cast<std::int32_t>(static_cast<std::uint32_t>(value));
+
+    return static_cast<long long>(value);
+}
@@ -1,13 +1,40 @@
 # pragma once
 
-#include <chrono>
-#include <iomanip>
+#include <charconv>
+#include <cstddef>
 #include <iostream>
 #include <string>
 
 using std::string;
 
 
+    /*************\
+    *  constants  *
+    \*************/
+
+// the most a formatted time point can take up, even with every field
+// as long as an int gets
+constexpr std::size_t TIME_POINT_TEXT_SIZE = 64;
+
+// the most characters an int takes
+constexpr std::size_t INT_TEXT_SIZE = 11;
+
+// "00" to "99" back to back, so two digits are written with one copy
+constexpr struct DigitPairs
+{
+    char digits[200];
+
+    constexpr DigitPairs() : digits()
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            digits[2 * i] = static_cast<char>('0' + i / 10);
+            digits[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+    }
+} DIGIT_PAIRS;
+
+
     /*************\
     *  TimePoint  *
     \*************/
@@ -58,7 +85,8 @@ struct TimePoint
     // minute ranges from 0 to 59
     int minute;
 
-    // purpose: sets the time point to right now
+    // purpose: sets the time point to right now, by the clock in use
+    //          (it's defined with the clocks, in clock.hpp)
     // requires: nothing
     // returns: nothing
     TimePoint();
@@ -139,6 +167,39 @@ struct TimePoint
     // returns: an integer
     static int daysInMonth(Months month, int year);
 
+    // purpose: counts the minutes from 1970/01/01 0000 to the time point,
+    //          with the real length of every month and year
+    // requires: nothing
+    // returns: the number of minutes, negative before 1970
+    long long toMinutes() const;
+
+    // purpose: finds the time point some minutes after 1970/01/01 0000
+    // requires: the number of minutes
+    // returns: the time point
+    static TimePoint fromMinutes(long long);
+
+    // purpose: writes the time point as YYYY/MM/DD HHMM, the way it's
+    //          shown, without going through a stream
+    // requires: a buffer with room for TIME_POINT_TEXT_SIZE characters
+    // returns: the end of what was written
+    char* format(char*) const;
+
+    // purpose: writes the time point in ISO 8601, YYYY-MM-DDTHH:MM
+    // requires: a buffer with room for TIME_POINT_TEXT_SIZE characters
+    // returns: the end of what was written
+    char* formatISO(char*) const;
+
+    // purpose: writes a number as at least two digits
+    // requires: a buffer and the number
+    // returns: the end of what was written
+    static char* writeTwoDigits(char*, int);
+
+    // purpose: writes a year as at least four digits, after a minus sign
+    //          if it's before year 0
+    // requires: a buffer and the year
+    // returns: the end of what was written
+    static char* writeYear(char*, int);
+
 };
 
 using Months = TimePoint::Months;
@@ -200,30 +261,6 @@ int operator-(Months a, Months b)
     *  time point constructors  *
     \***************************/
 
-// written by DeepSeek
-// default constructor
-// sets the time to right now
-TimePoint::TimePoint()
-{
-    // Get the current time point
-    const auto now = std::chrono::system_clock::now();
-
-    // Convert the time point to a time_t, which represents calendar time
-    std::time_t now_time_t = std::chrono::system_clock::to_time_t(now);
-
-    // Convert the time_t to a tm structure for local time using localtime_s
-    std::tm now_tm;
-    localtime_s(&now_tm, &now_time_t); // Use localtime_s on Windows
-
-    // Extract the year, month, day, hour, and minute from the tm structure
-    year = now_tm.tm_year + 1900; // tm_year is years since 1900
-    month = static_cast<Months>(now_tm.tm_mon + 1); // tm_mon is 0-based
-    day = now_tm.tm_mday;
-    hour = now_tm.tm_hour;
-    minute = now_tm.tm_min;
-
-}
-
 // co-written by DeepSeek
 // Constructor to handle rollover
 TimePoint::TimePoint(int y, Months m = January, int d = 1,
@@ -345,6 +382,108 @@ int TimePoint::daysInMonth(Months month, int year)
 
 }
 
+// count the minutes since 1970
+// the day count is Howard Hinnant's days_from_civil, which works in
+// 400 year eras that start on march 1st so the leap day comes last
+long long TimePoint::toMinutes() const
+{
+    long long y = year - (month <= February ? 1 : 0);
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yearOfEra = y - era * 400;
+    long long m = static_cast<int>(month);
+    long long dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100
+        + dayOfYear;
+    long long days = era * 146097 + dayOfEra - 719468;
+
+    return (days * 24 + hour) * 60 + minute;
+}
+
+// find the time point from the minutes since 1970
+// the inverse of the above, civil_from_days
+TimePoint TimePoint::fromMinutes(long long minutes)
+{
+    // round down, so times before 1970 land on the right day
+    long long days = minutes >= 0 ? minutes / 1440 : (minutes - 1439) / 1440;
+    long long ofDay = minutes - days * 1440;
+
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    long long dayOfEra = days - era * 146097;
+    long long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524
+        - dayOfEra / 146096) / 365;
+    long long dayOfYear = dayOfEra
+        - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long long mp = (5 * dayOfYear + 2) / 153;
+    int d = static_cast<int>(dayOfYear - (153 * mp + 2) / 5 + 1);
+    int m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    int y = static_cast<int>(yearOfEra + era * 400 + (m <= 2 ? 1 : 0));
+
+    return TimePoint(y, static_cast<Months>(m), d,
+        static_cast<int>(ofDay / 60), static_cast<int>(ofDay % 60));
+}
+
+
+// write the time point the way it's shown
+char* TimePoint::format(char* out) const
+{
+    out = writeYear(out, year);
+    *out++ = '/';
+    out = writeTwoDigits(out, static_cast<int>(month));
+    *out++ = '/';
+    out = writeTwoDigits(out, day);
+    *out++ = ' ';
+    out = writeTwoDigits(out, hour);
+
+    return writeTwoDigits(out, minute);
+}
+
+// write the time point in iso 8601
+char* TimePoint::formatISO(char* out) const
+{
+    out = writeYear(out, year);
+    *out++ = '-';
+    out = writeTwoDigits(out, static_cast<int>(month));
+    *out++ = '-';
+    out = writeTwoDigits(out, day);
+    *out++ = 'T';
+    out = writeTwoDigits(out, hour);
+    *out++ = ':';
+
+    return writeTwoDigits(out, minute);
+}
+
+// write at least two digits
+char* TimePoint::writeTwoDigits(char* out, int number)
+{
+    // anything the constructor didn't bring into range is written out
+    // in full
+    if (number < 0 || number > 99)
+        return std::to_chars(out, out + INT_TEXT_SIZE, number).ptr;
+
+    out[0] = DIGIT_PAIRS.digits[2 * number];
+    out[1] = DIGIT_PAIRS.digits[2 * number + 1];
+
+    return out + 2;
+}
+
+// write at least four digits of a year
+char* TimePoint::writeYear(char* out, int number)
+{
+    if (number < -9999 || number > 9999)
+        return std::to_chars(out, out + INT_TEXT_SIZE, number).ptr;
+
+    if (number < 0)
+    {
+        *out++ = '-';
+        number = -number;
+    }
+
+    out = writeTwoDigits(out, number / 100);
+
+    return writeTwoDigits(out, number % 100);
+}
+
 
     /************************\
     *  time point operators  *
@@ -442,7 +581,7 @@ double operator-(const TimePoint& a, const TimePoint& b)
 }
 
 // is a timepoint before or at the same time as another?
-static bool operator<=(const TimePoint& t, const TimePoint& other)
+bool operator<=(const TimePoint& t, const TimePoint& other)
 {
     if (t < other || t == other)
         return true;
@@ -451,7 +590,7 @@ static bool operator<=(const TimePoint& t, const TimePoint& other)
 }
 
 // is a timepoint after or at the same time as another
-static bool operator>=(const TimePoint& t, const TimePoint& other)
+bool operator>=(const TimePoint& t, const TimePoint& other)
 {
     if (t > other || t == other)
         return true;
@@ -460,22 +599,11 @@ static bool operator>=(const TimePoint& t, const TimePoint& other)
 }
 
 // give the time point the ability to be written
-static std::ostream& operator<<(std::ostream& os, const TimePoint& p)
+// it goes out in one write, so it leaves the stream's fill and width
+// the way it found them
+std::ostream& operator<<(std::ostream& os, const TimePoint& p)
 {
-    os << std::setw(4) << std::setfill('0') << p.year;
-
-    os << "/";
-
-    os << std::setw(2) << std::setfill('0') << static_cast<int>(p.month);
-
-    os << "/";
-
-    os << std::setw(2) << std::setfill('0') << p.day;
-
-    os << " ";
-
-    os << std::setw(2) << std::setfill('0') << p.hour;
-    os << std::setw(2) << std::setfill('0') << p.minute;
+    char text[TIME_POINT_TEXT_SIZE];
 
-    return os;
+    return os.write(text, p.format(text) - text);
 }
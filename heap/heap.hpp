@@ -0,0 +1,169 @@
+#pragma once
+
+
+// includes
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+// usings
+
+using std::size_t;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// these work on the same max-heap layout as std::make_heap, so the
+// standard heap functions can still be used on the result
+
+// purpose: moves an element up until its parent is at least as big
+// requires: a heap and the index of the element
+// returns: nothing
+template <typename adt>
+void siftUp(vector<adt>&, size_t);
+
+// purpose: moves an element down until its children are no bigger
+// requires: a heap and the index of the element
+// returns: nothing
+template <typename adt>
+void siftDown(vector<adt>&, size_t);
+
+// purpose: turns a vector into a heap in linear time (Floyd's method)
+// requires: a vector
+// returns: nothing
+template <typename adt>
+void heapify(vector<adt>&);
+
+// purpose: puts an element back in place after it changed
+// requires: a heap and the index of the element
+// returns: nothing
+template <typename adt>
+void fixHeap(vector<adt>&, size_t);
+
+// purpose: adds a batch of elements to a heap, then restores the heap
+//          with one heapify, or by sifting each new element up if the
+//          batch is small next to the heap
+// requires: a heap and the batch, which is moved from
+// returns: nothing
+template <typename adt>
+void bulkIngest(vector<adt>&, vector<adt>&&);
+
+// purpose: restores a heap after elements were appended to its end
+// requires: a heap, and how many elements were already in order
+// returns: nothing
+template <typename adt>
+void restoreHeap(vector<adt>&, size_t);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// sift an element up
+template <typename adt>
+void siftUp(vector<adt>& heap, size_t index)
+{
+    adt item = std::move(heap[index]);
+
+    // slide smaller parents down into the hole instead of swapping
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+
+        if (!(heap[parent] < item))
+            break;
+
+        heap[index] = std::move(heap[parent]);
+        index = parent;
+    }
+
+    heap[index] = std::move(item);
+}
+
+// sift an element down
+template <typename adt>
+void siftDown(vector<adt>& heap, size_t index)
+{
+    size_t size = heap.size();
+    adt item = std::move(heap[index]);
+
+    for (;;)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child >= size)
+            break;
+
+        // pick the bigger child
+        if (child + 1 < size && heap[child] < heap[child + 1])
+            child++;
+
+        if (!(item < heap[child]))
+            break;
+
+        heap[index] = std::move(heap[child]);
+        index = child;
+    }
+
+    heap[index] = std::move(item);
+}
+
+// build a heap from the bottom up
+template <typename adt>
+void heapify(vector<adt>& heap)
+{
+    // leaves are already heaps, so start at the last parent
+    for (size_t i = heap.size() / 2; i-- > 0; )
+        siftDown(heap, i);
+}
+
+// fix the heap around a changed element
+template <typename adt>
+void fixHeap(vector<adt>& heap, size_t index)
+{
+    if (index > 0 && heap[(index - 1) / 2] < heap[index])
+        siftUp(heap, index);
+    else
+        siftDown(heap, index);
+}
+
+// add a batch to the heap
+template <typename adt>
+void bulkIngest(vector<adt>& heap, vector<adt>&& batch)
+{
+    size_t ordered = heap.size();
+
+    heap.reserve(heap.size() + batch.size());
+    heap.insert(heap.end(), std::make_move_iterator(batch.begin()),
+        std::make_move_iterator(batch.end()));
+    batch.clear();
+
+    restoreHeap(heap, ordered);
+}
+
+// restore the heap after an append
+template <typename adt>
+void restoreHeap(vector<adt>& heap, size_t ordered)
+{
+    size_t added = heap.size() - ordered;
+    size_t depth = 0;
+
+    for (size_t n = heap.size(); n > 1; n >>= 1)
+        depth++;
+
+    // sifting each one up costs about added * depth,
+    // a full heapify costs about twice the size
+    if (added * depth < 2 * heap.size())
+    {
+        for (size_t i = ordered; i < heap.size(); i++)
+            siftUp(heap, i);
+    }
+    else
+        heapify(heap);
+}
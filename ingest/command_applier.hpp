@@ -0,0 +1,228 @@
+#pragma once
+
+
+// includes
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "command_queue.hpp"
+#include "../shell.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: reads a batch mode line into a command
+//          "make title;MM DD YYYY HH MM;importance;bias;description"
+//          "finish title;MM DD YYYY HH MM;importance;bias;description"
+//          "finish top"
+// requires: the line and a command to fill in
+// returns: false if the line isn't a command
+bool readBatchCommand(const string&, Command&);
+
+
+    /******************\
+    *  CommandApplier  *
+    \******************/
+
+// owns a dedicated thread that drains the command queue in batches and
+// applies every batch to the shell with one heap fix-up and one write
+// while it runs, the applier is the only thing allowed to touch the shell
+class CommandApplier
+{
+public:
+
+    // purpose: starts the applier thread
+    // requires: the shell to apply to, optionally the size of the queue
+    //           and the most commands applied in one batch
+    // returns: nothing
+    CommandApplier(Shell&, size_t capacity = 4096, size_t batchSize = 512);
+
+    CommandApplier(const CommandApplier&) = delete;
+    CommandApplier& operator=(const CommandApplier&) = delete;
+
+    // stops the thread after everything queued has been applied
+    ~CommandApplier() { stop(); }
+
+    // purpose: queues a command, waiting while the queue is full
+    //          safe to call from any number of producer threads
+    // requires: a command
+    // returns: false if the applier has been stopped
+    bool submit(const Command&);
+
+    // purpose: queues a command without waiting
+    // requires: a command
+    // returns: false if the queue is full or the applier has been stopped
+    bool trySubmit(const Command&);
+
+    // purpose: applies everything already queued and joins the thread
+    //          producers must be done submitting before this is called
+    // requires: nothing
+    // returns: nothing
+    void stop();
+
+private:
+
+    Shell& shell;
+    CommandQueue queue;
+    size_t batchSize;
+    std::atomic<bool> running;
+    std::thread worker;
+
+    // purpose: the body of the applier thread
+    // requires: nothing
+    // returns: nothing
+    void run();
+};
+
+
+    /******************************\
+    *  CommandApplier definitions  *
+    \******************************/
+
+// start the applier thread
+CommandApplier::CommandApplier(Shell& myShell, size_t capacity,
+    size_t maxBatch) : shell(myShell), queue(capacity), batchSize(maxBatch),
+    running(true)
+{
+    worker = std::thread(&CommandApplier::run, this);
+}
+
+// queue a command, spinning while the applier catches up
+bool CommandApplier::submit(const Command& cmd)
+{
+    while (running.load(std::memory_order_acquire))
+    {
+        if (queue.tryPush(cmd))
+            return true;
+
+        std::this_thread::yield();
+    }
+
+    return false;
+}
+
+// queue a command if there's room
+bool CommandApplier::trySubmit(const Command& cmd)
+{
+    if (!running.load(std::memory_order_acquire))
+        return false;
+
+    return queue.tryPush(cmd);
+}
+
+// drain the queue and join the thread
+void CommandApplier::stop()
+{
+    running.store(false, std::memory_order_release);
+
+    if (worker.joinable())
+        worker.join();
+}
+
+// drain the queue in batches until told to stop
+void CommandApplier::run()
+{
+    vector<Command> batch;
+    int idle = 0;
+
+    batch.reserve(batchSize);
+
+    for (;;)
+    {
+        // read the flag first so nothing queued before stop() is missed
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        queue.popBatch(batch, batchSize);
+
+        if (!batch.empty())
+        {
+            shell.applyCommands(batch);
+            batch.clear();
+            idle = 0;
+        }
+        else if (stopping)
+        {
+            break;
+        }
+        // back off when there's nothing to do
+        else if (++idle < 64)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// read a batch mode line
+bool readBatchCommand(const string& line, Command& cmd)
+{
+    string fields[5];
+    string record;
+    size_t field = 0;
+
+    if (line.compare(0, 5, "make ") == 0)
+    {
+        cmd.type = Command::Make;
+        record = line.substr(5);
+    }
+    else if (line == "finish top")
+    {
+        cmd.type = Command::FinishTop;
+        return true;
+    }
+    else if (line.compare(0, 7, "finish ") == 0)
+    {
+        cmd.type = Command::Finish;
+        record = line.substr(7);
+    }
+    else
+        return false;
+
+    // split the record on semicolons, the description keeps the rest
+    for (size_t i = 0; i < record.size(); i++)
+    {
+        if (record[i] == ';' && field < 4)
+            field++;
+        else
+            fields[field].push_back(record[i]);
+    }
+
+    // the title and due date are required
+    if (field < 1 || fields[0].empty())
+        return false;
+
+    try
+    {
+        cmd.importance = fields[2].empty()
+            ? 1 : static_cast<unsigned short>(stoi(fields[2]));
+        cmd.bias = fields[3].empty() ? 0.0 : stod(fields[3]);
+        cmd.due = parseDueDate(fields[1]);
+        cmd.title = fields[0];
+        cmd.description = fields[4];
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+
+// includes
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../event/event.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::string;
+using std::vector;
+
+
+    /***********\
+    *  Command  *
+    \***********/
+
+// a single operation submitted to the owner of the to do list
+// it carries its own copy of the event's strings, since producers can't
+// touch the list arena, only the owner of the list can
+struct Command
+{
+    enum Type
+    {
+        // add the event to the list
+        Make,
+        // remove the first event equal to the event
+        Finish,
+        // remove the most important event (the event is ignored)
+        FinishTop
+    };
+
+    Type type = Make;
+    string title;
+    string description;
+    // a plain date, since the default one asks the clock and the ring
+    // makes a command for every cell, only commands with an event set it
+    TimePoint due{ 1970, Months::January, 1, 0, 0 };
+    unsigned short importance = 1;
+    double bias = 0.0;
+
+    // purpose: builds the event, on the thread that owns the list
+    // requires: nothing
+    // returns: the event
+    Event toEvent() const
+    {
+        return Event(title, due, importance, bias, description);
+    }
+
+    // purpose: looks up the title and packs the due date, once, so a
+    //          whole list can be checked against the command without
+    //          looking them up for every event
+    // requires: somewhere to put the symbol and the packed due date
+    // returns: false if no event can match, since the title was never
+    //          used or the due date can't be stored
+    bool resolve(Symbol& symbol, std::int32_t& minutes) const
+    {
+        symbol = TITLES.find(title);
+        if (symbol == SymbolTable::NONE)
+            return false;
+
+        try
+        {
+            minutes = packDueDate(due);
+        }
+        catch (const std::out_of_range&)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // purpose: checks if an event is the one the command is about
+    // requires: an event, and the title and due date from resolve
+    // returns: true if all the event data is the same
+    bool matches(const Event& event, Symbol symbol,
+        std::int32_t minutes) const
+    {
+        return event.get_due_minutes() == minutes
+            && event.get_title() == symbol && event.get_bias() == bias
+            && event.get_importance() == importance
+            && event.get_description() == description;
+    }
+
+    // purpose: checks if an event is the one the command is about
+    // requires: an event
+    // returns: true if all the event data is the same
+    bool matches(const Event& event) const
+    {
+        Symbol symbol = SymbolTable::NONE;
+        std::int32_t minutes = 0;
+
+        return resolve(symbol, minutes) && matches(event, symbol, minutes);
+    }
+};
+
+
+    /**************\
+    *  RingBuffer  *
+    \**************/
+
+// a bounded, lock-free, multi-producer single-consumer ring buffer
+// every cell carries a sequence number that tells producers and the
+// consumer whose turn it is, so no locks are ever taken
+template <typename adt>
+class RingBuffer
+{
+public:
+
+    // purpose: allocates the cells of the ring
+    // requires: the capacity, rounded up to a power of two
+    // returns: nothing
+    explicit RingBuffer(size_t capacity);
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // purpose: tries to add an element to the ring, safe from any thread
+    // requires: an element
+    // returns: false if the ring is full
+    bool tryPush(const adt&);
+
+    // purpose: tries to take the oldest element off the ring,
+    //          only the single consumer may call this
+    // requires: somewhere to put the element
+    // returns: false if the ring is empty
+    bool tryPop(adt&);
+
+    // purpose: takes up to max elements off the ring in one go,
+    //          only the single consumer may call this
+    // requires: a vector to append to, and the most elements to take
+    // returns: the number of elements taken
+    size_t popBatch(vector<adt>&, size_t max);
+
+    // purpose: gets the number of cells in the ring
+    // requires: nothing
+    // returns: the capacity
+    size_t capacity() const { return mask + 1; }
+
+private:
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        adt data;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+
+    // producers and the consumer live on separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) size_t dequeuePos;
+};
+
+using CommandQueue = RingBuffer<Command>;
+
+
+    /**************************\
+    *  RingBuffer constructor  *
+    \**************************/
+
+// allocate the ring and number the cells
+template <typename adt>
+RingBuffer<adt>::RingBuffer(size_t capacity) : enqueuePos(0), dequeuePos(0)
+{
+    if (capacity < 2)
+        throw std::invalid_argument("A ring buffer needs at least two cells");
+
+    // round up to a power of two so positions can be masked
+    size_t size = 1;
+    while (size < capacity)
+        size <<= 1;
+
+    mask = size - 1;
+    cells.reset(new Cell[size]);
+
+    // a cell is free for position i when its sequence is i
+    for (size_t i = 0; i < size; i++)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+
+    /**********************\
+    *  RingBuffer methods  *
+    \**********************/
+
+// add an element to the ring
+template <typename adt>
+bool RingBuffer<adt>::tryPush(const adt& item)
+{
+    Cell* cell;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        cell = &cells[pos & mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        // the cell is free, try to claim the position
+        if (dif == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed))
+                break;
+        }
+        // the consumer hasn't freed the cell yet, so the ring is full
+        else if (dif < 0)
+            return false;
+        // another producer got here first
+        else
+            pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+
+    cell->data = item;
+
+    // hand the cell to the consumer
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+// take the oldest element off the ring
+template <typename adt>
+bool RingBuffer<adt>::tryPop(adt& item)
+{
+    Cell& cell = cells[dequeuePos & mask];
+    size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+    // the producer hasn't published this cell yet
+    if (seq != dequeuePos + 1)
+        return false;
+
+    item = std::move(cell.data);
+
+    // hand the cell back to the producers for the next lap
+    cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    ++dequeuePos;
+
+    return true;
+}
+
+// take a batch of elements off the ring
+template <typename adt>
+size_t RingBuffer<adt>::popBatch(vector<adt>& out, size_t max)
+{
+    size_t taken = 0;
+
+    while (taken < max)
+    {
+        Cell& cell = cells[dequeuePos & mask];
+
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+            break;
+
+        out.push_back(std::move(cell.data));
+        cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        ++taken;
+    }
+
+    return taken;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+
+// includes
+
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../event/event.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: splits a line of csv into its fields, handling quoted fields
+//          and doubled quotes inside them
+// requires: the line and a vector for the fields
+// returns: nothing
+void splitCSVLine(const string&, vector<string>&);
+
+// purpose: reads events from csv, one per line, with the columns
+//          title,description,importance,bias,due
+//          where due is "MM DD YYYY HH MM", a header line is skipped
+// requires: an input stream and a vector to append the events to
+// returns: the number of events read
+size_t readCSVEvents(std::istream&, vector<Event>&);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// split a csv line
+void splitCSVLine(const string& line, vector<string>& fields)
+{
+    string field;
+    bool quoted = false;
+
+    fields.clear();
+
+    for (size_t i = 0; i < line.size(); i++)
+    {
+        char c = line[i];
+
+        if (quoted)
+        {
+            if (c != '"')
+                field.push_back(c);
+            // a doubled quote is a quote
+            else if (i + 1 < line.size() && line[i + 1] == '"')
+                field.push_back(line[++i]);
+            else
+                quoted = false;
+        }
+        else if (c == '"')
+            quoted = true;
+        else if (c == ',')
+        {
+            fields.push_back(field);
+            field.clear();
+        }
+        // windows line endings
+        else if (c != '\r')
+            field.push_back(c);
+    }
+
+    fields.push_back(field);
+}
+
+// read events from csv
+size_t readCSVEvents(std::istream& in, vector<Event>& events)
+{
+    vector<string> fields;
+    string line;
+    size_t lineNumber = 0;
+    size_t count = 0;
+
+    while (getline(in, line))
+    {
+        lineNumber++;
+
+        if (line.empty() || line == "\r")
+            continue;
+
+        splitCSVLine(line, fields);
+
+        // skip the header
+        if (lineNumber == 1 && fields[0] == "title")
+            continue;
+
+        if (fields.size() != 5)
+            throw std::invalid_argument("Line " + std::to_string(lineNumber)
+                + " of the csv doesn't have 5 columns");
+
+        events.emplace_back(fields[0], parseDueDate(fields[4]),
+            static_cast<unsigned short>(stoi(fields[2])), stod(fields[3]),
+            fields[1]);
+        count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+
+// includes
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+// usings
+
+using std::string;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes sure everything written to a file is on the disk
+// requires: the path of the file
+// returns: nothing, throws runtime_error if it can't
+void syncFile(const string&);
+
+// purpose: renames a file over another in one step, so anything reading
+//          the target sees the old file or the new one, never half of one
+// requires: the file to rename and the path to give it
+// returns: nothing, throws runtime_error if it can't
+void replaceFile(const string& from, const string& to);
+
+// purpose: makes sure a rename in a file's directory is on the disk
+//          (only needed on posix, windows does it with the rename)
+// requires: the path of the file
+// returns: nothing
+void syncParentDirectory(const string&);
+
+// purpose: writes a file so a crash leaves the old file or the new one:
+//          the text goes in a temp file next to it, which is flushed to
+//          the disk and then renamed over the file
+// requires: the path, and something that writes the file to a stream
+// returns: nothing, throws runtime_error if the file couldn't be written
+template <typename writer>
+void writeFileAtomically(const string&, writer);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// flush a file to the disk
+void syncFile(const string& path)
+{
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    bool synced = fd >= 0 && _commit(fd) == 0;
+
+    if (fd >= 0)
+        _close(fd);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    bool synced = fd >= 0 && ::fsync(fd) == 0;
+
+    if (fd >= 0)
+        ::close(fd);
+#endif
+
+    if (!synced)
+        throw std::runtime_error("Couldn't flush \"" + path + "\" to disk");
+}
+
+// rename a file over another
+void replaceFile(const string& from, const string& to)
+{
+#ifdef _WIN32
+    // rename won't replace a file on windows
+    bool replaced = MoveFileExA(from.c_str(), to.c_str(),
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool replaced = std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+
+    if (!replaced)
+        throw std::runtime_error("Couldn't replace \"" + to + "\"");
+}
+
+// flush the directory entry of a file
+void syncParentDirectory(const string& path)
+{
+#ifndef _WIN32
+    size_t slash = path.find_last_of('/');
+    string directory = slash == string::npos ? "."
+        : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+
+    // not every file system lets a directory be synced, and the file
+    // itself is safe either way, so this one doesn't throw
+    if (fd >= 0)
+    {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+// write a file all at once or not at all
+template <typename writer>
+void writeFileAtomically(const string& path, writer write)
+{
+    string temp = path + ".tmp";
+
+    // whatever goes wrong, the half written temp file doesn't stay behind
+    try
+    {
+        {
+            std::ofstream out(temp, std::ios::out | std::ios::trunc
+                | std::ios::binary);
+
+            if (!out.is_open())
+                throw std::runtime_error("Couldn't open \"" + temp + "\"");
+
+            write(out);
+            out.flush();
+
+            if (!out)
+                throw std::runtime_error("Couldn't write \"" + temp + "\"");
+        }
+
+        syncFile(temp);
+        replaceFile(temp, path);
+    }
+    catch (...)
+    {
+        std::remove(temp.c_str());
+        throw;
+    }
+
+    syncParentDirectory(path);
+}
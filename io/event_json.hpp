@@ -0,0 +1,273 @@
+#pragma once
+
+
+// includes
+
+#include <stdexcept>
+#include <string>
+#include "../event/event.hpp"
+#include "../json.hpp"
+
+
+// usings
+
+using json = nlohmann::json;
+using std::string;
+
+
+    /*******************\
+    *  json conversion  *
+    \*******************/
+
+// lets json hold events and time points as they are, json(thing) and
+// j.get<Event>(), in the shape the list file gives them, so they go
+// through json::dump and to_cbor / to_msgpack / to_ubjson / to_bson and
+// back the same way
+// reading one looks at each member once, dispatching on the length of
+// its key, instead of looking every key up in the object, and like the
+// list file reader it fills in what's missing and skips what isn't a
+// number or string where one belongs
+namespace nlohmann
+{
+    template <>
+    struct adl_serializer<TimePoint>
+    {
+        // purpose: puts a time point in json as
+        //          { day, hour, minute, month, year }, the month by name
+        // requires: the json and the time point
+        // returns: nothing
+        static void to_json(json&, const TimePoint&);
+
+        // purpose: reads a time point back, the month can be its name or
+        //          its number
+        // requires: a json object
+        // returns: the time point, throws invalid_argument for a month
+        //          that isn't one, or type_error if it isn't an object
+        static TimePoint from_json(const json&);
+    };
+
+    template <>
+    struct adl_serializer<Event>
+    {
+        // purpose: puts an event in json like an entry of the list file
+        // requires: the json and the event
+        // returns: nothing
+        static void to_json(json&, const Event&);
+
+        // purpose: builds an event out of json, its strings go in the
+        //          list arena and it keeps the id it was saved with
+        // requires: a json object
+        // returns: the event, throws like the time point
+        static Event from_json(const json&);
+    };
+}
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: reads a month out of json
+// requires: its name or its number
+// returns: the month, throws invalid_argument if it isn't one
+Months jsonMonth(const json&);
+
+
+    /*****************************\
+    *  time point json functions  *
+    \*****************************/
+
+// put a time point in json
+void nlohmann::adl_serializer<TimePoint>::to_json(json& j,
+    const TimePoint& point)
+{
+    j = json::object();
+
+    // the keys go in the order the object keeps them, so each one goes
+    // straight on the end without a search
+    json::object_t& members = j.get_ref<json::object_t&>();
+
+    members.emplace_hint(members.end(), "day", point.day);
+    members.emplace_hint(members.end(), "hour", point.hour);
+    members.emplace_hint(members.end(), "minute", point.minute);
+    members.emplace_hint(members.end(), "month", mtos(point.month));
+    members.emplace_hint(members.end(), "year", point.year);
+}
+
+// get a time point out of json
+TimePoint nlohmann::adl_serializer<TimePoint>::from_json(const json& j)
+{
+    // the same blanks the list file reader starts from
+    int year = 0;
+    Months month = Months::January;
+    int day = 1;
+    int hour = 12;
+    int minute = 0;
+
+    for (auto &i : j.get_ref<const json::object_t&>())
+    {
+        const string& key = i.first;
+        const json& value = i.second;
+
+        if (key == "month")
+        {
+            if (value.is_string() || value.is_number())
+                month = jsonMonth(value);
+            continue;
+        }
+
+        if (!value.is_number())
+            continue;
+
+        // a number the field can't hold is left out, like a value of the
+        // wrong type
+        double number = value.get<double>();
+
+        switch (key.size())
+        {
+        case 3:
+            if (key == "day")
+                readWholeNumber(number, day);
+            break;
+        case 4:
+            if (key == "year")
+                readWholeNumber(number, year);
+            else if (key == "hour")
+                readWholeNumber(number, hour);
+            break;
+        case 6:
+            if (key == "minute")
+                readWholeNumber(number, minute);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return TimePoint(year, month, day, hour, minute);
+}
+
+
+    /************************\
+    *  event json functions  *
+    \************************/
+
+// put an event in json
+void nlohmann::adl_serializer<Event>::to_json(json& j, const Event& thing)
+{
+    j = json::object();
+
+    json::object_t& members = j.get_ref<json::object_t&>();
+
+    members.emplace_hint(members.end(), "bias", thing.get_bias());
+    members.emplace_hint(members.end(), "description",
+        thing.get_description());
+    members.emplace_hint(members.end(), "due_date", thing.get_due_date());
+    members.emplace_hint(members.end(), "id", thing.get_id());
+    members.emplace_hint(members.end(), "importance",
+        thing.get_importance());
+    if (thing.is_recurring())
+    {
+        char text[RECURRENCE_TEXT_SIZE];
+
+        members.emplace_hint(members.end(), "repeat", string(text,
+            formatRecurrence(text, thing.get_repeat())));
+    }
+    if (thing.get_zone() != 0)
+        members.emplace_hint(members.end(), "time_zone",
+            ZONES.zone(thing.get_zone()).name());
+    members.emplace_hint(members.end(), "title", thing.get_name());
+}
+
+// get an event out of json
+Event nlohmann::adl_serializer<Event>::from_json(const json& j)
+{
+    static const string blank;
+
+    const string* title = &blank;
+    const string* description = &blank;
+    const json* due = nullptr;
+    unsigned short importance = 1;
+    double bias = 0.0;
+    unsigned id = 0;
+    ZoneId zone = 0;
+    Recurrence repeat;
+
+    // every key has a length of its own, so the length picks the field
+    // and one comparison makes sure of it
+    for (auto &i : j.get_ref<const json::object_t&>())
+    {
+        const string& key = i.first;
+        const json& value = i.second;
+
+        switch (key.size())
+        {
+        case 2:
+            if (key == "id" && value.is_number())
+                readWholeNumber(value.get<double>(), id);
+            break;
+        case 4:
+            if (key == "bias" && value.is_number())
+                bias = value.get<double>();
+            break;
+        case 5:
+            if (key == "title" && value.is_string())
+                title = &value.get_ref<const string&>();
+            break;
+        case 6:
+            if (key == "repeat" && value.is_string())
+                readRecurrence(value.get_ref<const string&>(), repeat);
+            break;
+        case 8:
+            if (key == "due_date" && value.is_object())
+                due = &value;
+            break;
+        case 9:
+            if (key == "time_zone" && value.is_string())
+                zone = ZONES.find(value.get_ref<const string&>());
+            break;
+        case 10:
+            if (key == "importance" && value.is_number())
+                readWholeNumber(value.get<double>(), importance);
+            break;
+        case 11:
+            if (key == "description" && value.is_string())
+                description = &value.get_ref<const string&>();
+            break;
+        default:
+            break;
+        }
+    }
+
+    Event thing(*title, due != nullptr ? due->get<TimePoint>()
+        : TimePoint(0, Months::January, 1, 12, 0), importance, bias,
+        *description);
+
+    thing.set_id(id);
+    if (zone != 0)
+        thing.set_zone(zone);
+    if (repeat.frequency != Frequency::None)
+        thing.set_repeat(repeat);
+
+    return thing;
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// read a month
+Months jsonMonth(const json& value)
+{
+    if (value.is_string())
+        return stom(value.get_ref<const string&>());
+
+    int number = static_cast<int>(value.get<double>());
+
+    if (number < Months::January || number > Months::December)
+        throw std::invalid_argument("Not a month number: "
+            + std::to_string(number));
+
+    return static_cast<Months>(number);
+}
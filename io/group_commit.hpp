@@ -0,0 +1,242 @@
+#pragma once
+
+
+// includes
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "durable_file.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// how long a save waits for more saves to join it
+constexpr std::chrono::milliseconds GROUP_COMMIT_WINDOW(20);
+
+
+    /***************\
+    *  GroupCommit  *
+    \***************/
+
+// saves a file (and any added to it) atomically on its own thread, folding
+// every save asked for while one is waiting or being written into the next
+// one, so a burst of changes costs one write and one fsync instead of one each
+// the writer is called on the saving thread, so it has to lock whatever
+// it reads
+class GroupCommit
+{
+public:
+
+    using Writer = std::function<void(std::ostream&)>;
+
+    // purpose: starts the saving thread
+    // requires: the path of the file, what writes it,
+    //           and optionally how long saves wait to be grouped
+    // returns: nothing
+    GroupCommit(const string&, Writer,
+        std::chrono::milliseconds window = GROUP_COMMIT_WINDOW);
+
+    GroupCommit(const GroupCommit&) = delete;
+    GroupCommit& operator=(const GroupCommit&) = delete;
+
+    // saves whatever is still pending, then stops the thread
+    ~GroupCommit();
+
+    // purpose: adds another file that's saved along with the first, after
+    //          it, every time (each one on its own is still atomic)
+    // requires: the path of the file, and what writes it
+    // returns: nothing
+    void addFile(const string&, Writer);
+
+    // purpose: asks for the file to be saved, without waiting for it
+    // requires: nothing
+    // returns: nothing
+    void request();
+
+    // purpose: waits until every save asked for so far is on the disk
+    // requires: nothing
+    // returns: false if a save failed while it waited, the changes stay
+    //          asked for and the saving thread tries them again
+    bool flush();
+
+    // purpose: gets the number of times the file was actually written
+    // requires: nothing
+    // returns: the number of saves
+    unsigned long long saves() const;
+
+private:
+
+    // the files saved, in the order they're written
+    vector<std::pair<string, Writer>> files;
+    std::chrono::milliseconds window;
+
+    mutable std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable saved;
+
+    // how many saves were asked for, and how many of those are on disk
+    unsigned long long requested = 0;
+    unsigned long long durable = 0;
+    unsigned long long written = 0;
+    // how many saves failed
+    unsigned long long failed = 0;
+    // how many threads are waiting in flush
+    int flushing = 0;
+    bool stopping = false;
+
+    std::thread worker;
+
+    // purpose: the body of the saving thread
+    // requires: nothing
+    // returns: nothing
+    void run();
+};
+
+
+    /***********************\
+    *  GroupCommit methods  *
+    \***********************/
+
+// start the thread
+GroupCommit::GroupCommit(const string& file, Writer writer,
+    std::chrono::milliseconds wait) : window(wait)
+{
+    files.emplace_back(file, std::move(writer));
+    worker = std::thread(&GroupCommit::run, this);
+}
+
+// save what's left and stop
+GroupCommit::~GroupCommit()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+}
+
+// save another file too
+void GroupCommit::addFile(const string& file, Writer writer)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    files.emplace_back(file, std::move(writer));
+}
+
+// ask for a save
+void GroupCommit::request()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        requested++;
+    }
+
+    wake.notify_one();
+}
+
+// wait for the saves so far
+bool GroupCommit::flush()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    unsigned long long target = requested;
+    unsigned long long failedBefore = failed;
+
+    flushing++;
+    wake.notify_one();
+    saved.wait(guard, [&]
+    {
+        return durable >= target || failed != failedBefore;
+    });
+    flushing--;
+
+    return durable >= target;
+}
+
+// count the saves
+unsigned long long GroupCommit::saves() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    return written;
+}
+
+// save whenever asked to
+void GroupCommit::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    // whether the last save failed, so this one is trying it again
+    bool retrying = false;
+
+    for (;;)
+    {
+        wake.wait(guard, [this] { return stopping || requested != durable; });
+
+        if (requested == durable)
+            return;
+
+        // a failed save is tried again a window later, and once more
+        // when stopping
+        if (retrying)
+            wake.wait_for(guard, window, [this] { return stopping; });
+        // give the saves right behind this one a chance to join it,
+        // unless someone is waiting on it
+        else if (!stopping && flushing == 0)
+            wake.wait_for(guard, window,
+                [this] { return stopping || flushing > 0; });
+
+        // everything asked for up to now goes in this save
+        unsigned long long target = requested;
+        auto saving = files;
+
+        guard.unlock();
+
+        // a file that fails stops the ones after it, so none of them
+        // ends up newer than the first
+        try
+        {
+            for (auto &i : saving)
+                writeFileAtomically(i.first, i.second);
+            retrying = false;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Couldn't save the list: " << e.what() << "\n";
+            retrying = true;
+        }
+
+        guard.lock();
+
+        // the changes are only on the disk if every file made it
+        if (retrying)
+            failed++;
+        else
+        {
+            durable = target;
+            written++;
+        }
+        saved.notify_all();
+
+        // the last try on the way out failed, there's no one left to try
+        // again
+        if (retrying && stopping)
+            return;
+    }
+}
@@ -0,0 +1,286 @@
+#pragma once
+
+
+// includes
+
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// usings
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+
+    /**************\
+    *  JSONWriter  *
+    \**************/
+
+// writes json text straight into a buffer as it goes, without building
+// a json object first, either compact or indented like json::dump(n)
+// the caller is in charge of writing a well formed document, and may
+// empty the buffer between values to stream a big document out
+class JSONWriter
+{
+public:
+
+    // purpose: sets the writer up to append to a buffer
+    // requires: the buffer, and optionally how many spaces to indent by
+    //           (less than 0 writes everything compact on one line)
+    // returns: nothing
+    explicit JSONWriter(string& buffer, int indentWidth = -1) :
+        out(buffer), indent(indentWidth) { }
+
+    // purpose: opens an object or an array
+    // requires: nothing
+    // returns: nothing
+    void beginObject() { open('{'); }
+    void beginArray() { open('['); }
+
+    // purpose: closes the innermost object or array
+    // requires: nothing
+    // returns: nothing
+    void endObject() { close('}'); }
+    void endArray() { close(']'); }
+
+    // purpose: writes the key of the next member of an object
+    // requires: the key
+    // returns: nothing
+    void key(string_view);
+
+    // purpose: writes a value
+    // requires: the value
+    // returns: nothing
+    void value(string_view);
+    void value(const char* text) { value(string_view(text)); }
+    void value(long long);
+    void value(int number) { value(static_cast<long long>(number)); }
+    void value(unsigned number) { value(static_cast<long long>(number)); }
+    void value(double number) { floating(number); }
+    void value(float number) { floating(number); }
+    void value(bool);
+
+    // purpose: writes null
+    // requires: nothing
+    // returns: nothing
+    void null();
+
+    // purpose: appends a string to the buffer with json escapes
+    // requires: a buffer and the string
+    // returns: nothing
+    static void appendEscaped(string&, string_view);
+
+private:
+
+    string& out;
+
+    // spaces per level, or less than 0 for compact
+    int indent;
+
+    // one entry per open object or array, true until it gets a value
+    vector<bool> first;
+
+    // set right after a key, so the value doesn't get a comma
+    bool afterKey = false;
+
+    // purpose: writes a comma if the value isn't the first in its parent
+    // requires: nothing
+    // returns: nothing
+    void separate();
+
+    // purpose: starts a new line indented to the current depth,
+    //          if the writer isn't compact
+    // requires: nothing
+    // returns: nothing
+    void newline();
+
+    // purpose: writes a double or a float as the shortest text that reads
+    //          back to the same number, or null if it isn't finite
+    // requires: the number
+    // returns: nothing
+    template <typename real>
+    void floating(real);
+
+    // purpose: opens a nested object or array
+    // requires: the opening bracket
+    // returns: nothing
+    void open(char);
+
+    // purpose: closes the innermost object or array
+    // requires: the closing bracket
+    // returns: nothing
+    void close(char);
+};
+
+
+    /**********************\
+    *  JSONWriter methods  *
+    \**********************/
+
+// write the key of an object member
+void JSONWriter::key(string_view name)
+{
+    separate();
+    appendEscaped(out, name);
+    out += indent < 0 ? ":" : ": ";
+    afterKey = true;
+}
+
+// write a string
+void JSONWriter::value(string_view text)
+{
+    separate();
+    appendEscaped(out, text);
+}
+
+// write an integer
+void JSONWriter::value(long long number)
+{
+    char digits[24];
+
+    separate();
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    out.append(digits, result.ptr);
+}
+
+// write a floating point number
+template <typename real>
+void JSONWriter::floating(real number)
+{
+    char digits[32];
+
+    // json has no infinity or nan
+    if (!std::isfinite(number))
+    {
+        null();
+        return;
+    }
+
+    separate();
+
+    // the shortest text that reads back to the same number
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    out.append(digits, result.ptr);
+
+    // keep it a float when it's read back, like the json file has it
+    if (string_view(digits, result.ptr - digits).find_first_of(".e")
+        == string_view::npos)
+        out += ".0";
+}
+
+// write true or false
+void JSONWriter::value(bool flag)
+{
+    separate();
+    out += flag ? "true" : "false";
+}
+
+// write null
+void JSONWriter::null()
+{
+    separate();
+    out += "null";
+}
+
+// escape a string for json
+void JSONWriter::appendEscaped(string& buffer, string_view text)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    buffer.push_back('"');
+
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            buffer += "\\\"";
+            break;
+        case '\\':
+            buffer += "\\\\";
+            break;
+        case '\b':
+            buffer += "\\b";
+            break;
+        case '\f':
+            buffer += "\\f";
+            break;
+        case '\n':
+            buffer += "\\n";
+            break;
+        case '\r':
+            buffer += "\\r";
+            break;
+        case '\t':
+            buffer += "\\t";
+            break;
+        default:
+            // every other control character gets a unicode escape
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                buffer += "\\u00";
+                buffer.push_back(hex[(c >> 4) & 0xF]);
+                buffer.push_back(hex[c & 0xF]);
+            }
+            else
+                buffer.push_back(c);
+        }
+    }
+
+    buffer.push_back('"');
+}
+
+// write a comma between values
+void JSONWriter::separate()
+{
+    if (afterKey)
+    {
+        afterKey = false;
+        return;
+    }
+
+    if (!first.empty())
+    {
+        if (!first.back())
+            out.push_back(',');
+        first.back() = false;
+        newline();
+    }
+}
+
+// start an indented line
+void JSONWriter::newline()
+{
+    if (indent < 0)
+        return;
+
+    out.push_back('\n');
+    out.append(first.size() * static_cast<size_t>(indent), ' ');
+}
+
+// open an object or array
+void JSONWriter::open(char bracket)
+{
+    separate();
+    out.push_back(bracket);
+    first.push_back(true);
+}
+
+// close an object or array
+void JSONWriter::close(char bracket)
+{
+    bool empty = first.back();
+
+    first.pop_back();
+
+    // empty ones stay on one line, like {} and []
+    if (!empty)
+        newline();
+
+    out.push_back(bracket);
+}
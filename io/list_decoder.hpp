@@ -0,0 +1,754 @@
+#pragma once
+
+
+// includes
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "../event/event.hpp"
+#include "list_file.hpp"
+#include "structural_index.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// how deep values the list decoder skips can be nested, deeper ones are
+// left to the general parser
+constexpr int LIST_DECODER_MAX_DEPTH = 256;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: appends the text a json string stands for, i.e. with its
+//          escapes turned back into characters
+// requires: the string between its quotes, and where to append it
+// returns: false if it has an escape json doesn't allow
+bool unescapeJSON(string_view, string&);
+
+// purpose: determines if text is a json number
+// requires: the text
+// returns: true if it is
+bool isJSONNumber(string_view);
+
+// purpose: reads every event in the text of a list file with the list
+//          decoder, which knows the schema and works off a structural index
+// requires: the text and the parsed events to append to
+// returns: false if the text is anything the decoder doesn't handle
+//          (a month or time zone it can't take included, it never
+//          throws), and then what was appended is meaningless
+bool decodeListFile(string_view, ParsedEvents&);
+
+// purpose: reads a run of entries of a list, separated by commas, the
+//          way decodeListFile reads the whole list
+// requires: the text of the entries and the parsed events to append to
+// returns: false like decodeListFile
+bool decodeListEntries(string_view, ParsedEvents&);
+
+// purpose: reads every event in the text of a list file like
+//          readListEvents, with the list decoder when it can, falling back
+//          to the general parser (which also says what's wrong) when not
+// requires: the text and a vector to append the events to
+// returns: false if the text isn't json, and then nothing is appended
+bool readListEventsDecoded(string_view, vector<Event>&);
+
+
+    /***************\
+    *  ListDecoder  *
+    \***************/
+
+// reads the list file schema straight off a structural index, so it only
+// looks at the characters of the values it keeps
+// it takes the same things out of the file the sax ListReader does, and
+// gives up on whatever it isn't sure of, so the caller can hand the text
+// to the general parser instead
+class ListDecoder
+{
+public:
+
+    // purpose: indexes the text to decode
+    // requires: the text and the parsed events to append to
+    // returns: nothing
+    ListDecoder(string_view, ParsedEvents&);
+
+    // purpose: reads a whole list file
+    // requires: nothing
+    // returns: false if it gave up
+    bool file();
+
+    // purpose: reads a run of entries separated by commas
+    // requires: nothing
+    // returns: false if it gave up
+    bool entries();
+
+private:
+
+    string_view text;
+    ParsedEvents& events;
+    StructuralIndex index;
+    // where strings with escapes in them are unescaped
+    string scratch;
+
+    // purpose: gets the character the next token starts with
+    // requires: nothing
+    // returns: the character, or 0 at the end
+    char peek()
+    {
+        size_t at = index.position();
+
+        return at == StructuralIndex::npos ? '\0' : text[at];
+    }
+
+    // purpose: takes the next token if it's a character
+    // requires: the character
+    // returns: true if it was taken
+    bool expect(char c)
+    {
+        if (peek() != c)
+            return false;
+
+        index.advance();
+
+        return true;
+    }
+
+    // purpose: determines if the whole text has been read, and was valid
+    // requires: nothing
+    // returns: true if it was
+    bool finished()
+    {
+        return index.position() == StructuralIndex::npos && index.valid();
+    }
+
+    // purpose: reads a string
+    // requires: where to put it, good until the next string is read
+    // returns: false if it isn't a valid string
+    bool readString(string_view&);
+
+    // purpose: reads a string into the text of the parsed events
+    // requires: where to put its offset and length
+    // returns: false if it isn't a valid string
+    bool keepString(size_t&, size_t&);
+
+    // purpose: reads a number, or skips whatever else is there
+    // requires: where to put it, and a flag set if a number was read
+    // returns: false if it isn't a valid value
+    bool readNumber(double&, bool&);
+
+    // purpose: gets the number or literal the next token starts
+    // requires: nothing
+    // returns: its text, empty if there's no token left
+    string_view scalar();
+
+    // purpose: skips a value, checking it's valid
+    // requires: how deep it is
+    // returns: false if it isn't a valid value
+    bool skip(int);
+
+    // purpose: reads an entry of the list
+    // requires: nothing
+    // returns: false if it gave up
+    bool entry();
+
+    // purpose: reads an entry, or skips it if it isn't an object
+    // requires: nothing
+    // returns: false if it gave up
+    bool item() { return peek() == '{' ? entry() : skip(1); }
+
+    // purpose: reads the due date of an entry
+    // requires: its parts, which are set as they're found
+    // returns: false if it gave up
+    bool dueDate(int&, Months&, int&, int&, int&);
+};
+
+
+    /***********************\
+    *  ListDecoder methods  *
+    \***********************/
+
+// get ready to read
+ListDecoder::ListDecoder(string_view json, ParsedEvents& out) : text(json),
+    events(out), index(json)
+{
+}
+
+// read a list file
+bool ListDecoder::file()
+{
+    if (!expect('{'))
+        return false;
+
+    if (!expect('}'))
+    {
+        do
+        {
+            string_view key;
+
+            if (!readString(key) || !expect(':'))
+                return false;
+
+            // every list in the root is read, like the sax reader does
+            if (key == "to do list" && expect('['))
+            {
+                if (!expect(']'))
+                {
+                    do
+                    {
+                        if (!item())
+                            return false;
+                    } while (expect(','));
+
+                    if (!expect(']'))
+                        return false;
+                }
+            }
+            else if (!skip(1))
+                return false;
+
+        } while (expect(','));
+
+        if (!expect('}'))
+            return false;
+    }
+
+    return finished();
+}
+
+// read a run of entries
+bool ListDecoder::entries()
+{
+    do
+    {
+        if (!item())
+            return false;
+    } while (expect(','));
+
+    return finished();
+}
+
+// read a string
+bool ListDecoder::readString(string_view& value)
+{
+    if (peek() != '"')
+        return false;
+
+    // nothing inside a string is a token, so the next one closes it
+    size_t open = index.position();
+    size_t close = index.position(1);
+
+    if (close == StructuralIndex::npos)
+        return false;
+
+    index.advance(2);
+    value = text.substr(open + 1, close - open - 1);
+
+    // the whole string has been indexed, so if there was anything in it
+    // that needs a closer look it's been seen
+    if (index.nonASCII() && !isValidUTF8(value))
+        return false;
+
+    if (index.escapes() && value.find('\\') != string_view::npos)
+    {
+        scratch.clear();
+
+        if (!unescapeJSON(value, scratch))
+            return false;
+
+        value = scratch;
+    }
+
+    return true;
+}
+
+// read a string into the parsed events
+bool ListDecoder::keepString(size_t& at, size_t& length)
+{
+    string_view value;
+
+    if (!readString(value))
+        return false;
+
+    at = events.text.size();
+    length = value.size();
+    events.text.append(value);
+
+    return true;
+}
+
+// read a number
+bool ListDecoder::readNumber(double& value, bool& read)
+{
+    char c = peek();
+
+    read = false;
+
+    if (c != '-' && (c < '0' || c > '9'))
+        return skip(1);
+
+    string_view number = scalar();
+    size_t digits = number[0] == '-' ? 1 : 0;
+    double whole = 0.0;
+
+    // whole numbers are most of the file, and short ones come out exact
+    // adding up their digits
+    while (digits < number.size() && number[digits] >= '0'
+        && number[digits] <= '9')
+        whole = whole * 10 + (number[digits++] - '0');
+
+    if (digits == number.size() && digits <= 15 && isJSONNumber(number))
+        value = number[0] == '-' ? -whole : whole;
+    // out of range numbers are errors to the general parser
+    else if (!isJSONNumber(number)
+        || std::from_chars(number.data(), number.data() + number.size(),
+            value).ec != std::errc())
+        return false;
+
+    index.advance();
+    read = true;
+
+    return true;
+}
+
+// get the scalar at the next token
+string_view ListDecoder::scalar()
+{
+    size_t start = index.position();
+
+    if (start == StructuralIndex::npos)
+        return string_view();
+
+    return text.substr(start, index.scalarEnd(start) - start);
+}
+
+// skip a value
+bool ListDecoder::skip(int depth)
+{
+    char c = peek();
+
+    if (depth > LIST_DECODER_MAX_DEPTH)
+        return false;
+
+    if (c == '"')
+    {
+        string_view ignored;
+
+        return readString(ignored);
+    }
+
+    if (c == '{')
+    {
+        index.advance();
+
+        if (expect('}'))
+            return true;
+
+        do
+        {
+            string_view key;
+
+            if (!readString(key) || !expect(':') || !skip(depth + 1))
+                return false;
+        } while (expect(','));
+
+        return expect('}');
+    }
+
+    if (c == '[')
+    {
+        index.advance();
+
+        if (expect(']'))
+            return true;
+
+        do
+        {
+            if (!skip(depth + 1))
+                return false;
+        } while (expect(','));
+
+        return expect(']');
+    }
+
+    string_view word = scalar();
+
+    if (word != "true" && word != "false" && word != "null"
+        && !isJSONNumber(word))
+        return false;
+
+    index.advance();
+
+    return true;
+}
+
+// read an entry
+bool ListDecoder::entry()
+{
+    // the same blank event the sax reader starts with
+    size_t title = 0, titleLength = 0;
+    size_t description = 0, descriptionLength = 0;
+    int year = 0, day = 1, hour = 12, minute = 0;
+    Months month = Months::January;
+    unsigned short importance = 1;
+    double bias = 0.0;
+    unsigned id = 0;
+    ZoneId zone = 0;
+    Recurrence repeat;
+
+    if (!expect('{'))
+        return false;
+
+    if (!expect('}'))
+    {
+        do
+        {
+            string_view key;
+            double value;
+            bool read;
+            bool good;
+
+            if (!readString(key) || !expect(':'))
+                return false;
+
+            // anything that isn't the type the schema says is left out
+            if (key == "title")
+                good = peek() == '"' ? keepString(title, titleLength)
+                    : skip(2);
+            else if (key == "description")
+                good = peek() == '"'
+                    ? keepString(description, descriptionLength) : skip(2);
+            else if (key == "due_date")
+                good = peek() == '{'
+                    ? dueDate(year, month, day, hour, minute) : skip(2);
+            else if (key == "importance")
+            {
+                good = readNumber(value, read);
+                if (read)
+                    readWholeNumber(value, importance);
+            }
+            else if (key == "bias")
+            {
+                good = readNumber(value, read);
+                if (read)
+                    bias = value;
+            }
+            else if (key == "id")
+            {
+                good = readNumber(value, read);
+                if (read)
+                    readWholeNumber(value, id);
+            }
+            else if (key == "time_zone")
+            {
+                string_view name;
+
+                if (peek() != '"')
+                    good = skip(2);
+                else if ((good = readString(name)))
+                {
+                    // this may run off the main thread, so a full zone
+                    // table is left to the general parser to report
+                    try
+                    {
+                        zone = ZONES.find(name);
+                    }
+                    catch (const std::length_error&)
+                    {
+                        return false;
+                    }
+                }
+            }
+            else if (key == "repeat")
+            {
+                string_view rule;
+
+                if (peek() != '"')
+                    good = skip(2);
+                else if ((good = readString(rule)))
+                    readRecurrence(rule, repeat);
+            }
+            else
+                good = skip(2);
+
+            if (!good)
+                return false;
+
+        } while (expect(','));
+
+        if (!expect('}'))
+            return false;
+    }
+
+    events.entries.push_back({ title, titleLength, description,
+        descriptionLength, TimePoint(year, month, day, hour, minute),
+        importance, bias, id, zone, repeat });
+
+    return true;
+}
+
+// read a due date
+bool ListDecoder::dueDate(int& year, Months& month, int& day, int& hour,
+    int& minute)
+{
+    index.advance();
+
+    if (expect('}'))
+        return true;
+
+    do
+    {
+        string_view key;
+        double value;
+        bool read = false;
+        bool good;
+
+        if (!readString(key) || !expect(':'))
+            return false;
+
+        if (key == "month")
+        {
+            string_view name;
+
+            if (peek() != '"')
+                good = skip(3);
+            else if ((good = readString(name)))
+            {
+                // the general parser says what's wrong with it
+                try
+                {
+                    month = stom(name);
+                }
+                catch (const std::invalid_argument&)
+                {
+                    return false;
+                }
+            }
+        }
+        else if (key == "year" || key == "day" || key == "hour"
+            || key == "minute")
+        {
+            good = readNumber(value, read);
+            if (read)
+                readWholeNumber(value, key == "year" ? year
+                    : key == "day" ? day : key == "hour" ? hour : minute);
+        }
+        else
+            good = skip(3);
+
+        if (!good)
+            return false;
+
+    } while (expect(','));
+
+    return expect('}');
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// unescape a json string
+bool unescapeJSON(string_view raw, string& out)
+{
+    // purpose: reads the 4 hex digits of a \u escape
+    // requires: where they start
+    // returns: the code unit, or -1 if they aren't hex
+    auto hex = [&raw](size_t at)
+    {
+        long unit = 0;
+
+        if (at + 4 > raw.size())
+            return -1L;
+
+        for (size_t i = at; i < at + 4; i++)
+        {
+            char c = raw[i];
+
+            unit <<= 4;
+            if (c >= '0' && c <= '9')
+                unit |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                unit |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                unit |= c - 'A' + 10;
+            else
+                return -1L;
+        }
+
+        return unit;
+    };
+
+    size_t i = 0;
+
+    while (i < raw.size())
+    {
+        size_t slash = raw.find('\\', i);
+
+        // copy everything up to the next escape in one go
+        out.append(raw.substr(i, slash - i));
+
+        if (slash == string_view::npos)
+            break;
+
+        i = slash + 1;
+
+        if (i >= raw.size())
+            return false;
+
+        char c = raw[i++];
+        long code;
+
+        switch (c)
+        {
+        case '"': case '\\': case '/':
+            out.push_back(c);
+            continue;
+        case 'b':
+            out.push_back('\b');
+            continue;
+        case 'f':
+            out.push_back('\f');
+            continue;
+        case 'n':
+            out.push_back('\n');
+            continue;
+        case 'r':
+            out.push_back('\r');
+            continue;
+        case 't':
+            out.push_back('\t');
+            continue;
+        case 'u':
+            break;
+        default:
+            return false;
+        }
+
+        code = hex(i);
+        i += 4;
+
+        if (code < 0 || (code >= 0xdc00 && code <= 0xdfff))
+            return false;
+
+        // a high surrogate needs a low one right after it
+        if (code >= 0xd800 && code <= 0xdbff)
+        {
+            long low = i + 1 < raw.size() && raw[i] == '\\'
+                && raw[i + 1] == 'u' ? hex(i + 2) : -1L;
+
+            if (low < 0xdc00 || low > 0xdfff)
+                return false;
+
+            code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+            i += 6;
+        }
+
+        // and out it goes as utf-8
+        if (code < 0x80)
+            out.push_back(static_cast<char>(code));
+        else if (code < 0x800)
+        {
+            out.push_back(static_cast<char>(0xc0 | (code >> 6)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        }
+        else if (code < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xe0 | (code >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xf0 | (code >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+        }
+    }
+
+    return true;
+}
+
+// check a json number
+bool isJSONNumber(string_view word)
+{
+    size_t i = 0;
+    auto digits = [&word, &i]
+    {
+        size_t start = i;
+
+        while (i < word.size() && word[i] >= '0' && word[i] <= '9')
+            i++;
+
+        return i > start;
+    };
+
+    if (i < word.size() && word[i] == '-')
+        i++;
+
+    // no leading zeros
+    if (i < word.size() && word[i] == '0')
+        i++;
+    else if (!digits())
+        return false;
+
+    if (i < word.size() && word[i] == '.')
+    {
+        i++;
+        if (!digits())
+            return false;
+    }
+
+    if (i < word.size() && (word[i] == 'e' || word[i] == 'E'))
+    {
+        i++;
+        if (i < word.size() && (word[i] == '+' || word[i] == '-'))
+            i++;
+        if (!digits())
+            return false;
+    }
+
+    return i == word.size();
+}
+
+// decode a list file
+bool decodeListFile(string_view text, ParsedEvents& parsed)
+{
+    return ListDecoder(text, parsed).file();
+}
+
+// decode a run of entries
+bool decodeListEntries(string_view text, ParsedEvents& parsed)
+{
+    return ListDecoder(text, parsed).entries();
+}
+
+// read a list file, quickly if possible
+bool readListEventsDecoded(string_view text, vector<Event>& events)
+{
+    ParsedEvents parsed;
+
+    if (!decodeListFile(text, parsed))
+        return readListEvents(text, events);
+
+    events.reserve(events.size() + parsed.entries.size());
+    buildEvents(parsed, events);
+
+    return true;
+}
@@ -0,0 +1,531 @@
+#pragma once
+
+
+// includes
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../event/event.hpp"
+#include "../json.hpp"
+#include "json_writer.hpp"
+
+
+// usings
+
+using json = nlohmann::json;
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// how much of the list file is built up before it's handed to the stream
+constexpr size_t LIST_FLUSH_SIZE = 64 * 1024;
+
+
+    /****************\
+    *  ParsedEvents  *
+    \****************/
+
+// events read out of a list file before they're built, with their strings
+// in one buffer of their own instead of the list arena, so any thread can
+// read them
+struct ParsedEvents
+{
+    struct Entry
+    {
+        size_t title;
+        size_t titleLength;
+        size_t description;
+        size_t descriptionLength;
+        TimePoint due;
+        unsigned short importance;
+        double bias;
+        unsigned id;
+        ZoneId zone;
+        Recurrence repeat;
+    };
+
+    string text;
+    vector<Entry> entries;
+};
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// the list file is { "to do list": [ ... ] }, and every entry has
+// bias, description, due_date { day, hour, minute, month, year },
+// id, importance, and title, with the month written out by name, and a
+// time_zone like "Europe/Paris" if the due date is in one, and a repeat
+// rule like "FREQ=WEEKLY" if the event comes back
+
+// purpose: reads every event in the text of a list file straight into
+//          events, without building a json object first, keeping the
+//          saved ids (0 where there isn't one)
+// requires: the text and a vector to append the events to
+// returns: false if the text isn't json, and then nothing is appended
+bool readListEvents(string_view, vector<Event>&);
+
+// purpose: builds parsed events, their strings go in the list arena
+//          (this is the part that can't be spread over threads)
+// requires: the parsed events and a vector to append them to
+// returns: nothing
+void buildEvents(const ParsedEvents&, vector<Event>&);
+
+// purpose: reads a whole file in one go
+// requires: the path and a string to put the text in
+// returns: false if the file couldn't be opened
+bool readFileText(const string&, string&);
+
+// purpose: writes an event as an entry of the list file
+// requires: a json writer and an event
+// returns: nothing
+void writeStoredEvent(JSONWriter&, const Event&);
+
+// purpose: writes the whole list file straight from the events in one
+//          pass, without building a json object first, handing it to the
+//          stream a block at a time, indented by 4 or minified
+// requires: an output stream, the events, and optionally whether to minify
+// returns: nothing
+void writeListJSON(std::ostream&, const vector<Event>&, bool minified);
+
+
+    /**************\
+    *  ListReader  *
+    \**************/
+
+// the callbacks json::sax_parse makes while it reads a list file, which
+// fill in one event at a time and skip anything not in the schema
+class ListReader
+{
+public:
+
+    // purpose: sets the reader up to append to parsed events, reading
+    //          either a whole list file or just one entry of its list
+    // requires: the parsed events, and optionally true for one entry
+    // returns: nothing
+    explicit ListReader(ParsedEvents& out, bool entry = false) : events(out)
+    {
+        // an entry is read as if the root and the list were around it
+        if (entry)
+        {
+            depth = 2;
+            inList = true;
+        }
+    }
+
+    // the sax callbacks, each returns false to stop the parse
+    bool null() { return scalar(); }
+    bool boolean(bool) { return scalar(); }
+    bool number_integer(json::number_integer_t n) { return number(n); }
+    bool number_unsigned(json::number_unsigned_t n) { return number(n); }
+    bool number_float(json::number_float_t n, const json::string_t&)
+    {
+        return number(n);
+    }
+    bool string(json::string_t&);
+    bool binary(json::binary_t&) { return scalar(); }
+    bool start_object(size_t) { return open(true); }
+    bool end_object() { return close(true); }
+    bool start_array(size_t) { return open(false); }
+    bool end_array() { return close(false); }
+    bool key(json::string_t&);
+    bool parse_error(size_t, const std::string&,
+        const nlohmann::detail::exception&)
+    {
+        return false;
+    }
+
+private:
+
+    // where the next value goes
+    enum Field
+    {
+        None, List, Title, Description, Importance, Bias, Id, DueDate,
+        Zone, Repeat, Year, Month, Day, Hour, Minute
+    };
+
+    ParsedEvents& events;
+
+    // the root is depth 1, the list 2, an event 3, and its due date 4
+    int depth = 0;
+    // the depth of a value that's being skipped, 0 if none is
+    int skipping = 0;
+    bool inList = false;
+    Field field = None;
+
+    // the event being read, its strings go straight in the text of the
+    // parsed events
+    size_t title, titleLength;
+    size_t description, descriptionLength;
+    int year, day, hour, minute;
+    Months month;
+    unsigned short importance;
+    double bias;
+    unsigned id;
+    ZoneId zone;
+    Recurrence repeat;
+
+    // purpose: handles a value that isn't a string
+    // requires: the value as a double
+    // returns: true
+    bool number(double);
+
+    // purpose: handles a value that isn't used
+    // requires: nothing
+    // returns: true
+    bool scalar() { field = None; return true; }
+
+    // purpose: handles the start of an object or array
+    // requires: true for an object
+    // returns: true
+    bool open(bool);
+
+    // purpose: handles the end of an object or array
+    // requires: true for an object
+    // returns: true
+    bool close(bool);
+};
+
+
+    /**********************\
+    *  ListReader methods  *
+    \**********************/
+
+// read a key
+bool ListReader::key(json::string_t& name)
+{
+    if (skipping != 0)
+        return true;
+
+    field = None;
+
+    if (depth == 1 && name == "to do list")
+        field = List;
+    else if (depth == 3)
+    {
+        if (name == "title")
+            field = Title;
+        else if (name == "description")
+            field = Description;
+        else if (name == "importance")
+            field = Importance;
+        else if (name == "bias")
+            field = Bias;
+        else if (name == "id")
+            field = Id;
+        else if (name == "due_date")
+            field = DueDate;
+        else if (name == "time_zone")
+            field = Zone;
+        else if (name == "repeat")
+            field = Repeat;
+    }
+    else if (depth == 4)
+    {
+        if (name == "year")
+            field = Year;
+        else if (name == "month")
+            field = Month;
+        else if (name == "day")
+            field = Day;
+        else if (name == "hour")
+            field = Hour;
+        else if (name == "minute")
+            field = Minute;
+    }
+
+    return true;
+}
+
+// read a string value
+bool ListReader::string(json::string_t& text)
+{
+    if (skipping != 0)
+        return true;
+
+    if (field == Title)
+    {
+        title = events.text.size();
+        titleLength = text.size();
+        events.text.append(text);
+    }
+    else if (field == Description)
+    {
+        description = events.text.size();
+        descriptionLength = text.size();
+        events.text.append(text);
+    }
+    else if (field == Month)
+        month = stom(text);
+    else if (field == Zone)
+        zone = ZONES.find(text);
+    // a rule that can't be read is left out, like a value of the wrong type
+    else if (field == Repeat)
+        readRecurrence(text, repeat);
+
+    field = None;
+
+    return true;
+}
+
+// read a number
+bool ListReader::number(double value)
+{
+    if (skipping != 0)
+        return true;
+
+    // a number a field can't hold is left out, like a value of the
+    // wrong type
+    switch (field)
+    {
+    case Importance:
+        readWholeNumber(value, importance);
+        break;
+    case Bias:
+        bias = value;
+        break;
+    case Id:
+        readWholeNumber(value, id);
+        break;
+    case Year:
+        readWholeNumber(value, year);
+        break;
+    case Day:
+        readWholeNumber(value, day);
+        break;
+    case Hour:
+        readWholeNumber(value, hour);
+        break;
+    case Minute:
+        readWholeNumber(value, minute);
+        break;
+    default:
+        break;
+    }
+
+    field = None;
+
+    return true;
+}
+
+// go into an object or array
+bool ListReader::open(bool object)
+{
+    depth++;
+
+    if (skipping != 0)
+        return true;
+
+    // the root, the array of events, an event, and its due date are read,
+    // everything else gets skipped
+    bool wanted = (object && depth == 1)
+        || (!object && depth == 2 && field == List)
+        || (object && depth == 3 && inList)
+        || (object && depth == 4 && field == DueDate);
+
+    if (!wanted)
+        skipping = depth;
+    else if (!object)
+        inList = true;
+    // an event starts out blank
+    else if (depth == 3)
+    {
+        title = description = 0;
+        titleLength = descriptionLength = 0;
+        year = 0;
+        month = Months::January;
+        day = 1;
+        hour = 12;
+        minute = 0;
+        importance = 1;
+        bias = 0.0;
+        id = 0;
+        zone = 0;
+        repeat = Recurrence();
+    }
+
+    field = None;
+
+    return true;
+}
+
+// come out of an object or array
+bool ListReader::close(bool object)
+{
+    if (skipping == depth)
+        skipping = 0;
+    else if (skipping == 0 && object && depth == 3 && inList)
+        events.entries.push_back({ title, titleLength, description,
+            descriptionLength, TimePoint(year, month, day, hour, minute),
+            importance, bias, id, zone, repeat });
+    else if (skipping == 0 && !object && depth == 2)
+        inList = false;
+
+    depth--;
+    field = None;
+
+    return true;
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// read the events in a list file
+bool readListEvents(string_view text, vector<Event>& events)
+{
+    ParsedEvents parsed;
+    ListReader reader(parsed);
+
+    if (!json::sax_parse(text.begin(), text.end(), &reader))
+        return false;
+
+    events.reserve(events.size() + parsed.entries.size());
+    buildEvents(parsed, events);
+
+    return true;
+}
+
+// build parsed events
+void buildEvents(const ParsedEvents& parsed, vector<Event>& events)
+{
+    string_view text = parsed.text;
+
+    for (auto &i : parsed.entries)
+    {
+        // a due date that can't be stored loses just its own event
+        try
+        {
+            events.emplace_back(text.substr(i.title, i.titleLength), i.due,
+                i.importance, i.bias,
+                text.substr(i.description, i.descriptionLength));
+        }
+        catch (const std::out_of_range& e)
+        {
+            std::cerr << "Skipped \"" << text.substr(i.title, i.titleLength)
+                << "\" in the list file: " << e.what() << "\n";
+            continue;
+        }
+
+        events.back().set_id(i.id);
+        if (i.zone != 0)
+            events.back().set_zone(i.zone);
+        if (i.repeat.frequency != Frequency::None)
+            events.back().set_repeat(i.repeat);
+    }
+}
+
+// read a whole file
+bool readFileText(const string& path, string& text)
+{
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+
+    if (!in.is_open())
+        return false;
+
+    in.seekg(0, std::ios::end);
+    text.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(&text[0], static_cast<std::streamsize>(text.size()));
+
+    return true;
+}
+
+// write an event into the list file
+void writeStoredEvent(JSONWriter& writer, const Event& thing)
+{
+    TimePoint due = thing.get_due_date();
+
+    // the keys are in the order the file has always had them
+    writer.beginObject();
+    writer.key("bias");
+    writer.value(thing.get_bias());
+    writer.key("description");
+    writer.value(thing.get_description());
+
+    writer.key("due_date");
+    writer.beginObject();
+    writer.key("day");
+    writer.value(due.day);
+    writer.key("hour");
+    writer.value(due.hour);
+    writer.key("minute");
+    writer.value(due.minute);
+    writer.key("month");
+    writer.value(mtos(due.month));
+    writer.key("year");
+    writer.value(due.year);
+    writer.endObject();
+
+    writer.key("id");
+    writer.value(thing.get_id());
+    writer.key("importance");
+    writer.value(thing.get_importance());
+
+    // only an event that repeats has a rule
+    if (thing.is_recurring())
+    {
+        char text[RECURRENCE_TEXT_SIZE];
+
+        writer.key("repeat");
+        writer.value(string_view(text,
+            formatRecurrence(text, thing.get_repeat()) - text));
+    }
+
+    // only a due date in a time zone says which
+    if (thing.get_zone() != 0)
+    {
+        writer.key("time_zone");
+        writer.value(ZONES.zone(thing.get_zone()).name());
+    }
+
+    writer.key("title");
+    writer.value(thing.get_name());
+    writer.endObject();
+}
+
+// write the list file
+void writeListJSON(std::ostream& os, const vector<Event>& events,
+    bool minified = false)
+{
+    string buffer;
+    JSONWriter writer(buffer, minified ? -1 : 4);
+
+    buffer.reserve(LIST_FLUSH_SIZE + 1024);
+
+    writer.beginObject();
+    writer.key("to do list");
+    writer.beginArray();
+
+    for (auto &i : events)
+    {
+        writeStoredEvent(writer, i);
+
+        // the writer doesn't look back at the buffer, so it can be emptied
+        if (buffer.size() >= LIST_FLUSH_SIZE)
+        {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+    writer.endArray();
+    writer.endObject();
+    buffer.push_back('\n');
+
+    os.write(buffer.data(), buffer.size());
+}
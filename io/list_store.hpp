@@ -0,0 +1,453 @@
+#pragma once
+
+
+// includes
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "../event/event.hpp"
+#include "mapped_file.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::string;
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the first bytes of a list store, and the version of its layout
+constexpr char STORE_MAGIC[4] = { 'T', 'D', 'L', '1' };
+constexpr std::uint32_t STORE_VERSION = 3;
+
+
+    /****************\
+    *  store layout  *
+    \****************/
+
+// the list store is a copy of the list laid out so it can be mapped and
+// read as it is: the header, then a record per event in the order the
+// heap had them, then the records' positions in priority order as of the
+// save, then every string back to back, starting with the schedules the
+// events have, each the name of its time zone and its repeat rule
+// it's written in the machine's own byte order, it's only a cache of the
+// list file for the machine that saved it
+
+// the start of the store
+struct StoreHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t count;
+    // how many schedules the string heap starts with, each a time zone
+    // name and a repeat rule, both ending in a NUL and either one empty
+    std::uint32_t scheduleCount;
+    std::uint64_t stringBytes;
+};
+
+// an event, with its strings as places in the string heap
+struct StoreRecord
+{
+    double bias;
+    float priority;
+    std::int32_t due;
+    std::uint32_t titleOffset;
+    std::uint32_t titleLength;
+    std::uint32_t descriptionOffset;
+    std::uint32_t descriptionLength;
+    std::uint32_t id;
+    std::uint16_t importance;
+    // 0 for none, or 1 + which of the store's schedules
+    std::uint16_t schedule;
+};
+
+static_assert(sizeof(StoreHeader) == 24, "the store header is 24 bytes");
+static_assert(sizeof(StoreRecord) == 40, "a store record is 40 bytes");
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: writes the list as a list store
+// requires: an output stream and the events, in heap order
+// returns: nothing
+void writeListStore(std::ostream&, const vector<Event>&);
+
+// purpose: works out where the store of a list file goes, next to it with
+//          .bin in place of .json
+// requires: the path of the list file
+// returns: the path of the store
+string storePathFor(const string&);
+
+// purpose: determines if a store was saved after its list file, so it
+//          still has everything the list file has
+// requires: the paths of the list file and the store
+// returns: true if both are there and the store isn't older
+bool storeIsFresh(const string& listPath, const string& storePath);
+
+
+    /*************\
+    *  ListStore  *
+    \*************/
+
+// a list store mapped into memory, read in place without parsing it, so
+// opening one takes the same time however long the list is
+class ListStore
+{
+public:
+
+    // returned when an event can't be found
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // purpose: maps a store and checks its header
+    // requires: the path of the store
+    // returns: false if it isn't there or isn't a store this can read
+    bool open(const string&);
+
+    // purpose: unmaps the store
+    // requires: nothing
+    // returns: nothing
+    void close();
+
+    // purpose: determines if a store is mapped
+    // requires: nothing
+    // returns: true if it is
+    bool isOpen() const { return records != nullptr; }
+
+    // purpose: gets the number of events in the store
+    // requires: nothing
+    // returns: the number of events
+    size_t size() const { return count; }
+
+    // purpose: gets an event in heap order, 0 being the top
+    // requires: its index
+    // returns: the record, throws out_of_range if there isn't one
+    const StoreRecord& record(size_t) const;
+
+    // purpose: gets an event in priority order
+    // requires: its rank, 0 being the most important
+    // returns: the record, throws out_of_range if there isn't one
+    const StoreRecord& ranked(size_t) const;
+
+    // purpose: finds the rank right after an event, for paging
+    // requires: the id of the event
+    // returns: the rank after it, or npos if there's no such event
+    size_t rankAfter(unsigned) const;
+
+    // purpose: finds the first event in heap order with a title
+    // requires: the title
+    // returns: its index, or npos if there's no such event
+    size_t findTitle(string_view) const;
+
+    // purpose: gets a string out of the string heap
+    // requires: its offset and length
+    // returns: the string, throws out_of_range if it's outside the heap
+    string_view text(std::uint32_t, std::uint32_t) const;
+
+    // purpose: builds an event out of a record, its strings go in the
+    //          list arena and its priority is worked out again
+    // requires: a record from this store
+    // returns: the event
+    Event event(const StoreRecord&) const;
+
+private:
+
+    MappedFile file;
+    size_t count = 0;
+    const StoreRecord* records = nullptr;
+    const std::uint32_t* order = nullptr;
+    const char* strings = nullptr;
+    std::uint64_t stringBytes = 0;
+    // the store's schedules, by their number in a record
+    vector<Schedule> schedules;
+};
+
+
+    /*********************\
+    *  ListStore methods  *
+    \*********************/
+
+// map a store
+bool ListStore::open(const string& path)
+{
+    StoreHeader header;
+
+    close();
+
+    if (!file.open(path) || file.size() < sizeof(header))
+    {
+        close();
+        return false;
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    size_t tables = sizeof(header) + static_cast<size_t>(header.count)
+        * (sizeof(StoreRecord) + sizeof(std::uint32_t));
+
+    // the sizes have to add up, or the file was cut short or isn't a store
+    if (std::memcmp(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0
+        || header.version != STORE_VERSION
+        || header.scheduleCount > UINT16_MAX
+        || file.size() < tables
+        || file.size() - tables != header.stringBytes)
+    {
+        close();
+        return false;
+    }
+
+    // the mapping starts on a page, and the header keeps the records
+    // lined up for their doubles
+    count = header.count;
+    records = reinterpret_cast<const StoreRecord*>(file.data()
+        + sizeof(header));
+    order = reinterpret_cast<const std::uint32_t*>(records + count);
+    strings = reinterpret_cast<const char*>(order + count);
+    stringBytes = header.stringBytes;
+
+    // the schedules are few and short, so they're read once here instead
+    // of for every event
+    schedules.assign(1, Schedule());
+    for (size_t at = 0; schedules.size() <= header.scheduleCount; )
+    {
+        string_view fields[2];
+
+        for (auto &field : fields)
+        {
+            const char* end = at < stringBytes
+                ? static_cast<const char*>(std::memchr(strings + at, '\0',
+                    stringBytes - at)) : nullptr;
+
+            if (end == nullptr)
+            {
+                close();
+                return false;
+            }
+
+            field = string_view(strings + at, end - strings - at);
+            at = end - strings + 1;
+        }
+
+        schedules.emplace_back();
+        schedules.back().zone = ZONES.find(fields[0]);
+        readRecurrence(fields[1], schedules.back().repeat);
+    }
+
+    return true;
+}
+
+// unmap the store
+void ListStore::close()
+{
+    file.close();
+    count = 0;
+    records = nullptr;
+    order = nullptr;
+    strings = nullptr;
+    stringBytes = 0;
+    schedules.clear();
+}
+
+// get an event in heap order
+const StoreRecord& ListStore::record(size_t index) const
+{
+    if (index >= count)
+        throw std::out_of_range("There's no event " + std::to_string(index));
+
+    return records[index];
+}
+
+// get an event in priority order
+const StoreRecord& ListStore::ranked(size_t rank) const
+{
+    if (rank >= count)
+        throw std::out_of_range("There's no event ranked "
+            + std::to_string(rank));
+
+    // the order isn't checked when the store is opened, that would mean
+    // reading all of it
+    return record(order[rank]);
+}
+
+// find the rank after an event
+size_t ListStore::rankAfter(unsigned id) const
+{
+    for (size_t i = 0; i < count; i++)
+        if (order[i] < count && records[order[i]].id == id)
+            return i + 1;
+
+    return npos;
+}
+
+// find an event by its title
+size_t ListStore::findTitle(string_view title) const
+{
+    for (size_t i = 0; i < count; i++)
+        if (records[i].titleLength == title.size()
+            && text(records[i].titleOffset, records[i].titleLength) == title)
+            return i;
+
+    return npos;
+}
+
+// get a string out of the heap
+string_view ListStore::text(std::uint32_t offset, std::uint32_t length) const
+{
+    if (static_cast<std::uint64_t>(offset) + length > stringBytes)
+        throw std::out_of_range("The list store is damaged");
+
+    return string_view(strings + offset, length);
+}
+
+// build an event
+Event ListStore::event(const StoreRecord& stored) const
+{
+    Event thing(text(stored.titleOffset, stored.titleLength),
+        TimePoint::fromMinutes(stored.due), stored.importance, stored.bias,
+        text(stored.descriptionOffset, stored.descriptionLength));
+
+    thing.set_id(stored.id);
+    if (stored.schedule != 0 && stored.schedule < schedules.size())
+    {
+        const Schedule& schedule = schedules[stored.schedule];
+
+        thing.set_zone(schedule.zone);
+        thing.set_repeat(schedule.repeat);
+    }
+
+    return thing;
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// write the store
+void writeListStore(std::ostream& os, const vector<Event>& events)
+{
+    StoreHeader header{};
+    vector<StoreRecord> records(events.size());
+    vector<std::uint32_t> order(events.size());
+    string heap;
+    // where each title went in the heap, since titles repeat a lot
+    vector<std::uint32_t> titleOffsets(TITLES.size(), UINT32_MAX);
+    // the number each schedule in use has in the store
+    vector<std::uint16_t> scheduleNumbers(SCHEDULES.size(), 0);
+
+    // the schedules go first, so they can be read before any event
+    for (auto &i : events)
+    {
+        ScheduleId id = i.get_schedule();
+        char rule[RECURRENCE_TEXT_SIZE];
+
+        if (id == 0 || scheduleNumbers[id] != 0)
+            continue;
+
+        scheduleNumbers[id] = static_cast<std::uint16_t>(
+            ++header.scheduleCount);
+
+        if (i.get_zone() != 0)
+            heap.append(ZONES.zone(i.get_zone()).name());
+        heap.push_back('\0');
+        if (i.is_recurring())
+            heap.append(rule, formatRecurrence(rule, i.get_repeat()));
+        heap.push_back('\0');
+    }
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const Event& thing = events[i];
+        StoreRecord& stored = records[i];
+        Symbol title = thing.get_title();
+        string_view name = thing.get_name();
+        string_view description = thing.get_description();
+
+        if (titleOffsets[title] == UINT32_MAX)
+        {
+            titleOffsets[title] = static_cast<std::uint32_t>(heap.size());
+            heap.append(name);
+        }
+
+        stored.bias = thing.get_bias();
+        stored.priority = static_cast<float>(thing.get_priority());
+        stored.due = thing.get_due_minutes();
+        stored.titleOffset = titleOffsets[title];
+        stored.titleLength = static_cast<std::uint32_t>(name.size());
+        stored.descriptionOffset = static_cast<std::uint32_t>(heap.size());
+        stored.descriptionLength = static_cast<std::uint32_t>(
+            description.size());
+        stored.id = thing.get_id();
+        stored.importance = thing.get_importance();
+        stored.schedule = scheduleNumbers[thing.get_schedule()];
+
+        heap.append(description);
+
+        if (heap.size() > UINT32_MAX)
+            throw std::length_error("The list is too big for a list store");
+    }
+
+    // rank the events the way the sorted view does
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = static_cast<std::uint32_t>(i);
+
+    std::sort(order.begin(), order.end(),
+        [&events](std::uint32_t a, std::uint32_t b)
+        {
+            return events[a] > events[b];
+        });
+
+    std::memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+    header.version = STORE_VERSION;
+    header.count = static_cast<std::uint32_t>(events.size());
+    header.stringBytes = heap.size();
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char*>(records.data()),
+        static_cast<std::streamsize>(records.size() * sizeof(StoreRecord)));
+    os.write(reinterpret_cast<const char*>(order.data()),
+        static_cast<std::streamsize>(order.size() * sizeof(std::uint32_t)));
+    os.write(heap.data(), static_cast<std::streamsize>(heap.size()));
+}
+
+// find the store of a list file
+string storePathFor(const string& listPath)
+{
+    const string extension = ".json";
+
+    if (listPath.size() > extension.size()
+        && listPath.compare(listPath.size() - extension.size(),
+            extension.size(), extension) == 0)
+        return listPath.substr(0, listPath.size() - extension.size())
+            + ".bin";
+
+    return listPath + ".bin";
+}
+
+// check the store isn't behind the list file
+bool storeIsFresh(const string& listPath, const string& storePath)
+{
+    std::error_code error;
+    auto listTime = std::filesystem::last_write_time(listPath, error);
+
+    if (error)
+        return false;
+
+    auto storeTime = std::filesystem::last_write_time(storePath, error);
+
+    return !error && storeTime >= listTime;
+}
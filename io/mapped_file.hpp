@@ -0,0 +1,167 @@
+#pragma once
+
+
+// includes
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// usings
+
+using std::size_t;
+using std::string;
+
+
+    /**************\
+    *  MappedFile  *
+    \**************/
+
+// a whole file mapped read-only into memory, so it can be read without
+// copying it in first, pages are only loaded when they're touched
+class MappedFile
+{
+public:
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { close(); }
+
+    // purpose: maps a file, unmapping whatever was mapped before
+    // requires: the path of the file
+    // returns: false if it couldn't be mapped (or is empty)
+    bool open(const string&);
+
+    // purpose: unmaps the file
+    // requires: nothing
+    // returns: nothing
+    void close();
+
+    // purpose: gets the mapped bytes
+    // requires: nothing
+    // returns: a pointer to the start of the file, null if nothing's mapped
+    const char* data() const { return bytes; }
+
+    // purpose: gets the size of the mapping
+    // requires: nothing
+    // returns: the size of the file in bytes
+    size_t size() const { return length; }
+
+private:
+
+    const char* bytes = nullptr;
+    size_t length = 0;
+
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+
+    /**********************\
+    *  MappedFile methods  *
+    \**********************/
+
+// map a file
+bool MappedFile::open(const string& path)
+{
+    close();
+
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ
+        | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping != nullptr)
+        bytes = static_cast<const char*>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (bytes == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    length = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+
+    if (::fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* memory = ::mmap(nullptr, static_cast<size_t>(info.st_size),
+        PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping keeps the file alive on its own
+    ::close(fd);
+
+    if (memory == MAP_FAILED)
+        return false;
+
+    bytes = static_cast<const char*>(memory);
+    length = static_cast<size_t>(info.st_size);
+#endif
+
+    return true;
+}
+
+// unmap the file
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (bytes != nullptr)
+        UnmapViewOfFile(bytes);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if (bytes != nullptr)
+        ::munmap(const_cast<char*>(bytes), length);
+#endif
+
+    bytes = nullptr;
+    length = 0;
+}
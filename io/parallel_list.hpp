@@ -0,0 +1,258 @@
+#pragma once
+
+
+// includes
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../event/event.hpp"
+#include "../json.hpp"
+#include "list_decoder.hpp"
+#include "list_file.hpp"
+#include "structural_index.hpp"
+
+
+// usings
+
+using json = nlohmann::json;
+using std::size_t;
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// list files smaller than this are read on one thread, since starting
+// the others would take longer than reading them
+constexpr size_t PARALLEL_LOAD_MIN_BYTES = 1024 * 1024;
+
+// the least text each reading thread gets
+constexpr size_t PARALLEL_LOAD_MIN_SHARE = 256 * 1024;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: finds where every entry of the list in a list file starts and
+//          ends, by following the structural index without parsing
+//          anything
+// requires: the text and a vector to append the entries to
+// returns: false if the brackets or strings don't match up
+bool splitListEntries(string_view, vector<string_view>&);
+
+// purpose: reads every event in the text of a list file like
+//          readListEvents, but decodes the entries on several threads,
+//          each into its own buffer, and then builds them all in order
+// requires: the text, a vector to append the events to, and optionally
+//           how many threads to use (0 for one per core)
+// returns: false if the text isn't a list file, and then nothing is
+//          appended, throws what the serial reader would for a value it
+//          can't take (like a month that isn't one)
+bool readListEventsParallel(string_view, vector<Event>&, unsigned threads);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// find the entries of the list
+bool splitListEntries(string_view text, vector<string_view>& entries)
+{
+    StructuralIndex index(text);
+    int depth = 0;
+    // whether the next string in the root is a key, and whether the key
+    // just read was the list's
+    bool keyNext = false;
+    bool listKey = false;
+    bool inList = false;
+    bool rootDone = false;
+    // the start of the entry being passed over, and the end of the last
+    // token
+    size_t start = string_view::npos;
+    size_t last = 0;
+
+    for (size_t at; (at = index.position()) != StructuralIndex::npos;
+        index.advance())
+    {
+        char c = text[at];
+
+        // there's nothing but white space after the root
+        if (rootDone || (depth == 0 && c != '{'))
+            return false;
+
+        if (inList && depth == 2 && start == string_view::npos
+            && c != ',' && c != ']')
+            start = at;
+
+        switch (c)
+        {
+        case '"':
+        {
+            // the closing quote is the very next token
+            size_t end = index.position(1);
+
+            if (end == StructuralIndex::npos)
+                return false;
+
+            if (depth == 1 && keyNext)
+            {
+                listKey = text.substr(at + 1, end - at - 1) == "to do list";
+                keyNext = false;
+            }
+
+            index.advance();
+            last = end + 1;
+            continue;
+        }
+        case '{':
+            depth++;
+            keyNext = depth == 1;
+            listKey = false;
+            break;
+        case '[':
+            depth++;
+            inList = inList || (depth == 2 && listKey);
+            listKey = false;
+            break;
+        case ',':
+            if (inList && depth == 2)
+            {
+                if (start == string_view::npos)
+                    return false;
+                entries.push_back(text.substr(start, last - start));
+                start = string_view::npos;
+            }
+            keyNext = depth == 1;
+            break;
+        case '}':
+        case ']':
+            if (c == ']' && inList && depth == 2)
+            {
+                if (start != string_view::npos)
+                    entries.push_back(text.substr(start, last - start));
+                start = string_view::npos;
+                inList = false;
+            }
+            if (--depth < 0)
+                return false;
+            rootDone = depth == 0;
+            break;
+        case ':':
+            break;
+        default:
+            // a number or literal
+            last = index.scalarEnd(at);
+            continue;
+        }
+
+        last = at + 1;
+    }
+
+    // stray control characters and unclosed strings aren't split
+    return rootDone && index.valid();
+}
+
+// read the events in a list file on several threads
+bool readListEventsParallel(string_view text, vector<Event>& events,
+    unsigned threads = 0)
+{
+    vector<string_view> entries;
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    threads = static_cast<unsigned>(std::min<size_t>(threads,
+        text.size() / PARALLEL_LOAD_MIN_SHARE + 1));
+
+    // small files, and anything that doesn't split cleanly, go the usual
+    // way, which also says what's wrong with them
+    if (threads <= 1 || text.size() < PARALLEL_LOAD_MIN_BYTES
+        || !splitListEntries(text, entries) || entries.empty())
+        return readListEventsDecoded(text, events);
+
+    // hand each thread a run of entries with about the same amount of text
+    vector<size_t> firsts(1, 0);
+    size_t share = text.size() / threads + 1;
+    size_t taken = 0;
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        taken += entries[i].size();
+
+        // the last entry never starts a run, or the run would be empty
+        if (taken >= share * firsts.size() && firsts.size() < threads
+            && i + 1 < entries.size())
+            firsts.push_back(i + 1);
+    }
+    firsts.push_back(entries.size());
+
+    vector<ParsedEvents> parsed(firsts.size() - 1);
+    vector<char> good(parsed.size(), 1);
+    // what each thread threw, since a throw can't leave a thread
+    vector<std::exception_ptr> errors(parsed.size());
+    vector<std::thread> workers;
+
+    for (size_t t = 0; t < parsed.size(); t++)
+    {
+        workers.emplace_back([&, t]
+        {
+            const char* from = entries[firsts[t]].data();
+            const string_view& to = entries[firsts[t + 1] - 1];
+
+            try
+            {
+                // the decoder takes the whole run at once, anything it
+                // gives up on is parsed again one entry at a time
+                if (decodeListEntries(string_view(from,
+                    to.data() + to.size() - from), parsed[t]))
+                    return;
+
+                parsed[t] = ParsedEvents();
+
+                ListReader reader(parsed[t], true);
+
+                for (size_t i = firsts[t]; i < firsts[t + 1] && good[t];
+                    i++)
+                    good[t] = json::sax_parse(entries[i].begin(),
+                        entries[i].end(), &reader);
+            }
+            catch (...)
+            {
+                errors[t] = std::current_exception();
+                good[t] = 0;
+            }
+        });
+    }
+
+    for (auto &i : workers)
+        i.join();
+
+    // the runs are in the file's order, so the first one that went wrong
+    // is what the serial reader would have run into
+    for (size_t t = 0; t < parsed.size(); t++)
+    {
+        if (errors[t])
+            std::rethrow_exception(errors[t]);
+        if (!good[t])
+            return false;
+    }
+
+    // the strings have to be interned on one thread, in the file's order
+    size_t total = events.size();
+
+    for (auto &i : parsed)
+        total += i.entries.size();
+
+    events.reserve(total);
+    for (auto &i : parsed)
+        buildEvents(i, events);
+
+    return true;
+}
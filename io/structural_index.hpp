@@ -0,0 +1,493 @@
+#pragma once
+
+
+// includes
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+// usings
+
+using std::size_t;
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// how much text is indexed at a time, small enough that its tokens stay
+// in the cache until they're used
+constexpr size_t STRUCTURAL_CHUNK_SIZE = 16 * 1024;
+
+// the characters that end a number or literal
+constexpr struct DelimiterTable
+{
+    bool ends[256];
+
+    constexpr DelimiterTable() : ends()
+    {
+        for (char c : { ' ', '\t', '\n', '\r', ',', ':', '{', '}', '[', ']',
+            '"' })
+            ends[static_cast<unsigned char>(c)] = true;
+    }
+
+    constexpr bool operator[](unsigned char c) const { return ends[c]; }
+} JSON_DELIMITERS;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: determines if text is well formed utf-8, the way json wants it
+//          (no overlong forms, surrogates, or code points past U+10FFFF)
+// requires: the text
+// returns: true if it is
+bool isValidUTF8(string_view);
+
+
+    /*******************\
+    *  StructuralIndex  *
+    \*******************/
+
+// where the tokens of some json text start: every bracket, brace, colon,
+// and comma outside a string, every quote that isn't escaped, and the first
+// character of every number or literal
+// they're found 64 bytes at a time with masks instead of a character at a
+// time (with sse2 or avx2 when the compiler targets them), a chunk ahead
+// of whatever is reading them, so the index never has to be kept whole
+class StructuralIndex
+{
+public:
+
+    // returned when the text runs out of tokens
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // purpose: sets the index up to go through some text
+    // requires: the text
+    // returns: nothing
+    explicit StructuralIndex(string_view);
+
+    // purpose: gets where a token is, indexing more text if it has to
+    // requires: how many tokens past the current one it is
+    // returns: its position in the text, or npos if there aren't that many
+    size_t position(size_t ahead = 0)
+    {
+        while (cursor + ahead >= count)
+            if (!scan())
+                return npos;
+
+        return tokens[cursor + ahead];
+    }
+
+    // purpose: finds where the number or literal at a token ends
+    // requires: its position
+    // returns: the position right after it
+    size_t scalarEnd(size_t start) const
+    {
+        while (start < text.size()
+            && !JSON_DELIMITERS[static_cast<unsigned char>(text[start])])
+            start++;
+
+        return start;
+    }
+
+    // purpose: moves past tokens
+    // requires: how many
+    // returns: nothing
+    void advance(size_t by = 1) { cursor += by; }
+
+    // purpose: determines if the text, once it's all been gone through,
+    //          had every string closed and no raw control characters in one
+    // requires: nothing
+    // returns: true if it did
+    bool valid() const { return stringCarry == 0 && control == 0; }
+
+    // purpose: determines if a backslash has turned up yet, so strings
+    //          read so far might need unescaping
+    // requires: nothing
+    // returns: true if one has
+    bool escapes() const { return backslash != 0; }
+
+    // purpose: determines if a byte past ascii has turned up yet, so
+    //          strings read so far might need their utf-8 checking
+    // requires: nothing
+    // returns: true if one has
+    bool nonASCII() const { return high != 0; }
+
+private:
+
+    string_view text;
+    // how far the text has been indexed
+    size_t at = 0;
+    // the tokens found and not gone past yet
+    vector<size_t> tokens;
+    size_t cursor = 0;
+    size_t count = 0;
+
+    // what carries over from one block to the next
+    std::uint64_t escapeCarry = 0;
+    std::uint64_t stringCarry = 0;
+    std::uint64_t scalarCarry = 0;
+    std::uint64_t control = 0;
+    std::uint64_t backslash = 0;
+    std::uint64_t high = 0;
+
+    // purpose: indexes the next chunk of text
+    // requires: nothing
+    // returns: false if there's no text left
+    bool scan();
+};
+
+
+    /*************\
+    *  internals  *
+    \*************/
+
+// the masks of one 64 byte block, a bit per byte
+struct BlockMasks
+{
+    std::uint64_t quote;
+    std::uint64_t backslash;
+    // brackets, braces, colons, and commas
+    std::uint64_t op;
+    std::uint64_t space;
+    // bytes below 0x20
+    std::uint64_t control;
+    // bytes past 0x7f
+    std::uint64_t high;
+};
+
+// purpose: works out the masks of a block
+// requires: 64 bytes
+// returns: the masks
+inline BlockMasks classifyBlock(const char* block)
+{
+    BlockMasks m = { 0, 0, 0, 0, 0, 0 };
+
+#if defined(__AVX2__)
+    for (int half = 0; half < 2; half++)
+    {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(block + 32 * half));
+        // '[' and ']' are '{' and '}' with 0x20 taken off
+        __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        auto bits = [](__m256i mask)
+        {
+            return static_cast<std::uint64_t>(
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(mask)));
+        };
+        auto is = [&v](char c)
+        {
+            return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+        };
+        int shift = 32 * half;
+
+        m.quote |= bits(is('"')) << shift;
+        m.backslash |= bits(is('\\')) << shift;
+        m.op |= bits(_mm256_or_si256(_mm256_or_si256(
+            _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+            _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+            _mm256_or_si256(is(':'), is(',')))) << shift;
+        m.space |= bits(_mm256_or_si256(_mm256_or_si256(is(' '), is('\t')),
+            _mm256_or_si256(is('\n'), is('\r')))) << shift;
+        m.control |= bits(_mm256_cmpeq_epi8(v,
+            _mm256_min_epu8(v, _mm256_set1_epi8(0x1f)))) << shift;
+        m.high |= bits(v) << shift;
+    }
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    for (int quarter = 0; quarter < 4; quarter++)
+    {
+        __m128i v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(block + 16 * quarter));
+        // '[' and ']' are '{' and '}' with 0x20 taken off
+        __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        auto bits = [](__m128i mask)
+        {
+            return static_cast<std::uint64_t>(_mm_movemask_epi8(mask));
+        };
+        auto is = [&v](char c)
+        {
+            return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+        };
+        int shift = 16 * quarter;
+
+        m.quote |= bits(is('"')) << shift;
+        m.backslash |= bits(is('\\')) << shift;
+        m.op |= bits(_mm_or_si128(_mm_or_si128(
+            _mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+            _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+            _mm_or_si128(is(':'), is(',')))) << shift;
+        m.space |= bits(_mm_or_si128(_mm_or_si128(is(' '), is('\t')),
+            _mm_or_si128(is('\n'), is('\r')))) << shift;
+        m.control |= bits(_mm_cmpeq_epi8(v,
+            _mm_min_epu8(v, _mm_set1_epi8(0x1f)))) << shift;
+        m.high |= bits(v) << shift;
+    }
+#else
+    for (int i = 0; i < 64; i++)
+    {
+        unsigned char c = static_cast<unsigned char>(block[i]);
+        std::uint64_t bit = std::uint64_t(1) << i;
+
+        if (c == '"')
+            m.quote |= bit;
+        else if (c == '\\')
+            m.backslash |= bit;
+        else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':'
+            || c == ',')
+            m.op |= bit;
+
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+            m.space |= bit;
+        if (c < 0x20)
+            m.control |= bit;
+        if (c >= 0x80)
+            m.high |= bit;
+    }
+#endif
+
+    return m;
+}
+
+// purpose: works out which bits are inside a string, i.e. the running xor
+//          of the quotes
+// requires: the quote mask
+// returns: the mask, with the opening quotes in it and the closing ones not
+inline std::uint64_t prefixXor(std::uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+
+    return bits;
+}
+
+// purpose: finds the characters that come right after an odd run of
+//          backslashes, carrying a run over from the block before
+// requires: the backslash mask, and whether the last block ended in an
+//           unfinished escape (updated for the next block)
+// returns: the mask of escaped characters
+inline std::uint64_t findEscaped(std::uint64_t backslash,
+    std::uint64_t& carry)
+{
+    const std::uint64_t odd = 0xaaaaaaaaaaaaaaaaULL;
+
+    if (backslash == 0)
+    {
+        std::uint64_t escaped = carry;
+
+        carry = 0;
+
+        return escaped;
+    }
+
+    // a backslash that's escaped itself can't start an escape
+    std::uint64_t starts = backslash & ~carry;
+    // subtracting turns each run of backslashes into a pattern that says,
+    // with the odd bits, which characters in and after it are escaped
+    std::uint64_t codes = (((starts << 1) | odd) - starts) ^ odd;
+    std::uint64_t escaped = codes ^ (backslash | carry);
+
+    carry = (codes & backslash) >> 63;
+
+    return escaped;
+}
+
+// purpose: finds the lowest set bit
+// requires: a mask that isn't 0
+// returns: its index
+inline int lowestBit(std::uint64_t bits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+
+    _BitScanForward64(&index, bits);
+
+    return static_cast<int>(index);
+#elif defined(_MSC_VER)
+    unsigned long index;
+
+    if (_BitScanForward(&index, static_cast<unsigned long>(bits)))
+        return static_cast<int>(index);
+
+    _BitScanForward(&index, static_cast<unsigned long>(bits >> 32));
+
+    return static_cast<int>(index) + 32;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+
+    /***************************\
+    *  StructuralIndex methods  *
+    \***************************/
+
+// get ready to index
+StructuralIndex::StructuralIndex(string_view json) : text(json)
+{
+    // a chunk has at most a token per byte, plus the few kept over
+    tokens.resize(STRUCTURAL_CHUNK_SIZE + 64);
+}
+
+// index a chunk
+bool StructuralIndex::scan()
+{
+    char tail[64];
+
+    if (at >= text.size())
+        return false;
+
+    // slide the tokens that haven't been gone past down to the front
+    std::copy(tokens.begin() + cursor, tokens.begin() + count,
+        tokens.begin());
+    count -= cursor;
+    cursor = 0;
+
+    if (tokens.size() < count + STRUCTURAL_CHUNK_SIZE)
+        tokens.resize(count + STRUCTURAL_CHUNK_SIZE);
+
+    size_t* out = tokens.data() + count;
+    size_t stop = std::min(text.size(), at + STRUCTURAL_CHUNK_SIZE);
+
+    for (; at < stop; at += 64)
+    {
+        const char* block = text.data() + at;
+
+        // the last block is padded out with spaces
+        if (text.size() - at < 64)
+        {
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, block, text.size() - at);
+            block = tail;
+        }
+
+        BlockMasks m = classifyBlock(block);
+        std::uint64_t quote = m.quote & ~findEscaped(m.backslash,
+            escapeCarry);
+        std::uint64_t inString = prefixXor(quote) ^ stringCarry;
+        std::uint64_t interior = inString & ~quote;
+
+        stringCarry = static_cast<std::uint64_t>(
+            static_cast<std::int64_t>(inString) >> 63);
+
+        // a number or literal starts wherever a run of anything else does
+        std::uint64_t scalar = ~(m.op | m.space | quote | interior);
+        std::uint64_t scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+
+        scalarCarry = scalar >> 63;
+
+        control |= m.control & interior;
+        backslash |= m.backslash;
+        high |= m.high;
+
+        std::uint64_t found = (m.op & ~interior) | quote | scalarStart;
+
+        while (found != 0)
+        {
+            *out++ = at + lowestBit(found);
+            found &= found - 1;
+        }
+    }
+
+    count = out - tokens.data();
+
+    return true;
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// check utf-8
+bool isValidUTF8(string_view text)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(
+        text.data());
+    size_t size = text.size();
+    size_t i = 0;
+
+    while (i < size)
+    {
+        // skip ascii 8 bytes at a time
+        if (i + 8 <= size)
+        {
+            std::uint64_t word;
+
+            std::memcpy(&word, p + i, sizeof(word));
+
+            if ((word & 0x8080808080808080ULL) == 0)
+            {
+                i += 8;
+                continue;
+            }
+        }
+
+        unsigned char c = p[i];
+        int length;
+        unsigned low = 0x80;
+        unsigned high = 0xbf;
+
+        if (c < 0x80)
+        {
+            i++;
+            continue;
+        }
+        else if (c >= 0xc2 && c <= 0xdf)
+            length = 2;
+        else if (c >= 0xe0 && c <= 0xef)
+        {
+            length = 3;
+            // no overlong forms, and no surrogates
+            if (c == 0xe0)
+                low = 0xa0;
+            else if (c == 0xed)
+                high = 0x9f;
+        }
+        else if (c >= 0xf0 && c <= 0xf4)
+        {
+            length = 4;
+            // no overlong forms, and nothing past U+10FFFF
+            if (c == 0xf0)
+                low = 0x90;
+            else if (c == 0xf4)
+                high = 0x8f;
+        }
+        else
+            return false;
+
+        if (i + length > size || p[i + 1] < low || p[i + 1] > high)
+            return false;
+
+        for (int k = 2; k < length; k++)
+            if (p[i + k] < 0x80 || p[i + k] > 0xbf)
+                return false;
+
+        i += length;
+    }
+
+    return true;
+}
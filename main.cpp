@@ -11,9 +11,12 @@
 
 #include "event/event.hpp"
 #include <fstream>
+#include "ingest/command_applier.hpp"
 #include "json.hpp"
 #include <iomanip>
 #include <iostream>
+#include <cstdlib>
+#include <memory>
 #include "shell.hpp"
 #include <string>
 
@@ -28,16 +31,105 @@ using std::ifstream;
 using std::ofstream;
 
 
+// prototypes
+
+// purpose: feeds make/finish lines from standard input to the shell
+//          through the command queue, one line per command
+// requires: the shell
+// returns: the exit code
+int runBatch(Shell&);
+
+// purpose: runs the shell on commands the user types until they quit
+// requires: the shell
+// returns: the exit code
+int runInteractive(Shell&);
+
+
     /********\
     *  main  *
     \********/
 
-int main()
+int main(int argc, char* argv[])
 {
     //ifstream jsonFile;
     //json jsonData;
     vector<Event> myHeap;
-    Shell daShell("to_do_list.json", myHeap);
+    bool batch = false;
+    bool minify = false;
+    bool readOnly = false;
+    // the clock, when it isn't the system's, and what it's set up from
+    std::unique_ptr<Clock> timeSource;
+    string start;
+    double speed = 0.0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        // batch mode reads commands from standard input instead of the user
+        if (string(argv[i]) == "--batch")
+            batch = true;
+        // save the list file without indents and line breaks
+        else if (string(argv[i]) == "--minify")
+            minify = true;
+        // only look at the list, straight from the list store
+        else if (string(argv[i]) == "--read-only")
+            readOnly = true;
+        // pin the clock at a time instead of reading the system's
+        else if (string(argv[i]) == "--now" && i + 1 < argc)
+            start = argv[++i];
+        // run the clock this many times faster than real time
+        else if (string(argv[i]) == "--speed" && i + 1 < argc)
+            speed = std::atof(argv[++i]);
+    }
+
+    try
+    {
+        TimePoint from = start.empty() ? currentTime() : parseDueDate(start);
+
+        if (speed > 0.0)
+            timeSource = std::make_unique<SimulatedClock>(from, speed);
+        else if (!start.empty())
+            timeSource = std::make_unique<FixedClock>(from);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "--now " << e.what() << "\n";
+        return 1;
+    }
+
+    if (timeSource)
+        useClock(*timeSource);
+
+    if (readOnly)
+    {
+        if (batch)
+        {
+            std::cerr << "--batch can't change a read-only list\n";
+            return 1;
+        }
+
+        Shell daShell("to_do_list.json", Shell::ReadOnly);
+
+        return runInteractive(daShell);
+    }
+
+    // the first save can happen while the shell starts up, so it has to
+    // know how to write the file by then
+    Shell daShell("to_do_list.json", myHeap, minify);
+
+    if (batch)
+        return runBatch(daShell);
+
+    return runInteractive(daShell);
+}
+
+
+    /*************\
+    *  functions  *
+    \*************/
+
+// run the shell for the user
+int runInteractive(Shell& daShell)
+{
     vector<string> cmds;
 
     do
@@ -46,9 +138,41 @@ int main()
         cmds = daShell.getCommand();
 
         // run the command
-        daShell.runCommand(cmds);
+        daShell.runCommand(std::move(cmds));
 
     } while (daShell.isRunning());
 
     return 0;
 }
+
+// run the shell in batch mode
+int runBatch(Shell& daShell)
+{
+    CommandApplier applier(daShell);
+    Command cmd;
+    string line;
+    int lineNumber = 0;
+    int rejected = 0;
+
+    while (getline(cin, line))
+    {
+        lineNumber++;
+
+        if (line.empty())
+            continue;
+
+        if (readBatchCommand(line, cmd))
+            applier.submit(cmd);
+        else
+        {
+            std::cerr << "line " << lineNumber << ": \"" << line
+                << "\" unknown\n";
+            rejected++;
+        }
+    }
+
+    // apply whatever is still queued
+    applier.stop();
+
+    return rejected == 0 ? 0 : 1;
+}
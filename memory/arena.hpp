@@ -0,0 +1,162 @@
+#pragma once
+
+
+// includes
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+// usings
+
+using std::size_t;
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the size of each block the arena hands memory out of
+constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+
+    /*********\
+    *  Arena  *
+    \*********/
+
+// hands out memory by bumping a pointer through big blocks, and gives it
+// all back at once, so lots of small allocations that live and die
+// together cost next to nothing
+// nothing is freed one at a time, and it isn't safe to share across threads
+class Arena
+{
+public:
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // purpose: hands out a chunk of memory
+    // requires: the size, and optionally the alignment (a power of two)
+    // returns: a pointer to the memory
+    void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    // purpose: copies a string into the arena
+    // requires: the string
+    // returns: a view of the copy, good until the arena is reset
+    string_view store(string_view);
+
+    // purpose: gives back everything handed out, keeping one block around
+    //          for the next round
+    // requires: nothing
+    // returns: nothing
+    void reset();
+
+    // purpose: gets the number of bytes handed out since the last reset
+    // requires: nothing
+    // returns: the number of bytes
+    size_t bytesUsed() const { return used; }
+
+    // purpose: gets the number of bytes held onto from the system
+    // requires: nothing
+    // returns: the number of bytes
+    size_t bytesReserved() const { return reserved; }
+
+private:
+
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    vector<Block> blocks;
+    char* next = nullptr;
+    char* limit = nullptr;
+    size_t used = 0;
+    size_t reserved = 0;
+
+    // purpose: gets a new block big enough for an allocation
+    // requires: the size of the allocation
+    // returns: nothing
+    void grow(size_t);
+};
+
+
+    /*****************\
+    *  Arena methods  *
+    \*****************/
+
+// hand out some memory
+void* Arena::allocate(size_t size, size_t align)
+{
+    // round the pointer up to the alignment
+    size_t pad = (align - reinterpret_cast<size_t>(next) % align) % align;
+
+    if (next == nullptr || pad + size > static_cast<size_t>(limit - next))
+    {
+        grow(size + align);
+        pad = (align - reinterpret_cast<size_t>(next) % align) % align;
+    }
+
+    char* memory = next + pad;
+
+    next = memory + size;
+    used += size;
+
+    return memory;
+}
+
+// copy a string into the arena
+string_view Arena::store(string_view text)
+{
+    if (text.empty())
+        return string_view();
+
+    char* copy = static_cast<char*>(allocate(text.size(), 1));
+
+    std::memcpy(copy, text.data(), text.size());
+
+    return string_view(copy, text.size());
+}
+
+// give everything back
+void Arena::reset()
+{
+    // hold onto the first block, it'll just be needed again
+    if (blocks.size() > 1)
+        blocks.erase(blocks.begin() + 1, blocks.end());
+
+    if (blocks.empty())
+    {
+        next = limit = nullptr;
+        reserved = 0;
+    }
+    else
+    {
+        next = blocks[0].data.get();
+        limit = next + blocks[0].size;
+        reserved = blocks[0].size;
+    }
+
+    used = 0;
+}
+
+// get a new block
+void Arena::grow(size_t size)
+{
+    // big strings get a block all to themselves
+    size_t blockSize = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+
+    blocks.push_back({ std::unique_ptr<char[]>(new char[blockSize]),
+        blockSize });
+
+    next = blocks.back().data.get();
+    limit = next + blockSize;
+    reserved += blockSize;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+
+// includes
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "arena.hpp"
+
+
+// usings
+
+using std::string_view;
+using std::vector;
+
+
+    /*************\
+    *  ColdStore  *
+    \*************/
+
+// keeps text that is rarely looked at (like descriptions) away from the
+// data that gets sorted and sifted, which only carries a slot number
+// the text has its own arena, so it doesn't spread out the hot strings
+class ColdStore
+{
+public:
+
+    using Slot = std::uint32_t;
+
+    // the slot of empty text, it's never stored
+    static constexpr Slot EMPTY = 0;
+
+    ColdStore() { reset(); }
+    ColdStore(const ColdStore&) = delete;
+    ColdStore& operator=(const ColdStore&) = delete;
+
+    // purpose: copies text into the store
+    // requires: the text
+    // returns: its slot, or EMPTY if the text is empty
+    Slot store(string_view);
+
+    // purpose: gets the text in a slot
+    // requires: a slot from this store
+    // returns: the text, good until the store is reset
+    string_view get(Slot slot) const { return texts[slot]; }
+
+    // purpose: gets the number of slots handed out
+    // requires: nothing
+    // returns: the number of slots
+    size_t size() const { return texts.size() - 1; }
+
+    // purpose: gets the number of bytes of text kept
+    // requires: nothing
+    // returns: the number of bytes
+    size_t bytesUsed() const { return arena.bytesUsed(); }
+
+    // purpose: forgets all the text
+    // requires: nothing
+    // returns: nothing
+    void reset();
+
+private:
+
+    Arena arena;
+    vector<string_view> texts;
+};
+
+
+    /*********************\
+    *  ColdStore methods  *
+    \*********************/
+
+// copy text in
+ColdStore::Slot ColdStore::store(string_view text)
+{
+    if (text.empty())
+        return EMPTY;
+
+    texts.push_back(arena.store(text));
+
+    return static_cast<Slot>(texts.size() - 1);
+}
+
+// forget everything
+void ColdStore::reset()
+{
+    arena.reset();
+    texts.clear();
+
+    // slot 0 is the empty text
+    texts.push_back(string_view());
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+
+// includes
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "arena.hpp"
+
+
+// usings
+
+using std::string_view;
+using std::vector;
+
+// a string that has been interned, i.e. its number in the symbol table
+using Symbol = std::uint32_t;
+
+
+    /***************\
+    *  SymbolTable  *
+    \***************/
+
+// stores each distinct string once and hands out a number for it, so
+// strings that come up over and over are kept once and compared as ints
+// the bytes live in an arena, so the table has to be reset with it
+class SymbolTable
+{
+public:
+
+    // returned by find when the string was never interned
+    static constexpr Symbol NONE = static_cast<Symbol>(-1);
+
+    // purpose: sets the table up to keep its strings in an arena
+    // requires: the arena
+    // returns: nothing
+    explicit SymbolTable(Arena& store) : arena(store) { reset(); }
+
+    // purpose: gets the symbol for a string, adding it if it's new
+    // requires: the string
+    // returns: the symbol
+    Symbol intern(string_view);
+
+    // purpose: gets the symbol for a string without adding it
+    // requires: the string
+    // returns: the symbol, or NONE if it was never interned
+    Symbol find(string_view) const;
+
+    // purpose: gets the string a symbol stands for
+    // requires: a symbol from this table
+    // returns: the string
+    string_view name(Symbol symbol) const { return names[symbol]; }
+
+    // purpose: gets the number of distinct strings
+    // requires: nothing
+    // returns: the size
+    size_t size() const { return names.size(); }
+
+    // purpose: forgets every string, for when the arena is reset
+    //          the empty string is always symbol 0
+    // requires: nothing
+    // returns: nothing
+    void reset();
+
+private:
+
+    Arena& arena;
+    vector<string_view> names;
+    std::unordered_map<string_view, Symbol> symbols;
+};
+
+
+    /***********************\
+    *  SymbolTable methods  *
+    \***********************/
+
+// intern a string
+Symbol SymbolTable::intern(string_view text)
+{
+    auto found = symbols.find(text);
+
+    if (found != symbols.end())
+        return found->second;
+
+    // the key has to point at the copy, not at the caller's string
+    string_view stored = arena.store(text);
+    Symbol symbol = static_cast<Symbol>(names.size());
+
+    names.push_back(stored);
+    symbols.emplace(stored, symbol);
+
+    return symbol;
+}
+
+// look a string up
+Symbol SymbolTable::find(string_view text) const
+{
+    auto found = symbols.find(text);
+
+    return found == symbols.end() ? NONE : found->second;
+}
+
+// forget everything
+void SymbolTable::reset()
+{
+    names.clear();
+    symbols.clear();
+
+    names.push_back(string_view());
+    symbols.emplace(string_view(), 0);
+}
@@ -6,11 +6,26 @@
 #include <algorithm>
 #include "event/event.hpp"
 #include <fstream>
+#include "heap/heap.hpp"
+#include "ingest/command_queue.hpp"
+#include "io/csv.hpp"
+#include "io/group_commit.hpp"
+#include "io/list_file.hpp"
+#include "io/list_store.hpp"
+#include "io/parallel_list.hpp"
 #include <iomanip>
 #include <iostream>
 #include "json.hpp"
+#include <map>
+#include <mutex>
 #include <queue>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
 #include <vector>
+#include "view/jsonl.hpp"
+#include "view/render.hpp"
+#include "view/sorted_view.hpp"
 
 
 // usings
@@ -19,9 +34,10 @@ using json = nlohmann::json;
 using std::cout;
 using std::cin;
 using std::endl;
-using std::fstream;
+using std::map;
 using std::ostream;
 using std::string;
+using std::string_view;
 using std::queue;
 using std::vector;
 
@@ -43,6 +59,10 @@ void printHeap(vector<adt>&);
 class Shell
 {
 public:
+
+    // whether the list can be changed, a read-only shell never writes
+    // and answers views straight from the list store when it's up to date
+    enum OpenMode { ReadWrite, ReadOnly };
     
         /***********************\
         *  default constructor  *
@@ -69,9 +89,10 @@ public:
 
     // purpose: opens the json file, assigns the heap to the one passed
     //          through, sets the shell running, and prints the command line
-    // requires: the file name, and a heap
+    // requires: the file name, a heap, and optionally true to save the
+    //           list file minified
     // returns: nothing
-    Shell(const string, vector<Event>&);
+    Shell(const string, vector<Event>&, bool minified);
 
     // purpose: opens the json file, dynamically allocates the heap with the
     //          event passed through, sets the shell running, and prints the
@@ -80,6 +101,14 @@ public:
     // returns: nothing
     Shell(const string fileName, const Event& myEvent);
 
+    // purpose: opens the json file, or in read-only mode maps its list
+    //          store instead, so it starts up in the same time however
+    //          long the list is, sets the shell running, and prints the
+    //          command list
+    // requires: the file name, and the mode
+    // returns: nothing
+    Shell(const string, OpenMode);
+
 
         /********************\
         *  member functions  *
@@ -96,17 +125,49 @@ public:
     vector<string> getCommand() const;
 
     // purpose: actually runs the commands
-    // requires: a vector of strings, i.e. individual keywords
+    // requires: a vector of strings, i.e. individual keywords,
+    //           moved in since the options get pulled out of it
     // returns:: nothing
     void runCommand(vector<string>);
 
+    // purpose: applies a batch of queued commands with a single heap
+    //          fix-up and a single write to the json file
+    // requires: a batch of commands
+    // returns: nothing
+    void applyCommands(const vector<Command>&);
+
 private:
 
     bool is_running;
     bool ownsHeap;
-    fstream jsonFile;
+    // the json file the list is kept in, the events are the only copy
+    // of the list in memory and the file is written straight from them
+    string listFile;
     vector<Event> toDoList;
-    json jsonData;
+
+    // the list store saved next to the list file, and the mapping of it
+    // a read-only shell answers views from
+    string storeFile = storePathFor(listFile);
+    ListStore store;
+
+    // whether the list can't be changed
+    bool readOnly = false;
+
+    // whether the list file is written without indents and line breaks
+    bool minifyFile = false;
+
+    // the id the next new event gets
+    unsigned nextId = 1;
+
+    // the list sorted by priority, for paging through it
+    SortedView sortedView;
+
+    // held while the list is read or changed, since it's saved on
+    // the saving thread
+    std::mutex listMutex;
+
+    // saves the list file atomically, a burst of changes in one go
+    GroupCommit saver{ listFile, [this](std::ostream& os) { saveList(os); } };
 
     // purpose: adds an event to the list
     // requires: an event
@@ -114,39 +175,94 @@ private:
     void addEvent(const Event& myEvent)
     {
         toDoList.push_back(myEvent);
-        push_heap(toDoList.begin(), toDoList.end());
+        assignId(toDoList.back());
+        sortedView.insert(toDoList.back());
+        siftUp(toDoList, toDoList.size() - 1);
     }
 
+    // purpose: moves the time priorities are worked out from up to the
+    //          clock's time, and if it moved, works every priority out
+    //          again and rebuilds the heap
+    // requires: the list mutex, or no other thread running
+    // returns: nothing
+    void catchUpClock();
+
+    // purpose: gives an event the next id if it doesn't have one yet,
+    //          and makes sure later ids come after the one it has
+    // requires: an event
+    // returns: nothing
+    void assignId(Event&);
+
+    // purpose: pulls "--name=value" and "--name value" options out of
+    //          the command line
+    // requires: the command line
+    // returns: the options by name
+    map<string, string> extractOptions(vector<string>&) const;
+
+    // purpose: prints a page of the list in priority order
+    // requires: the options, "limit" and "after" pick the page
+    //           and "format" picks text or jsonl
+    // returns: nothing
+    void viewList(map<string, string>&);
+
+    // purpose: answers a view command from the mapped list store, with
+    //          the order the list had when it was saved
+    // requires: the command line and the options
+    // returns: nothing
+    void viewStore(const vector<string>&, map<string, string>&);
+
+    // purpose: prints an event in the format the user asked for
+    // requires: an event and the format, "text" or "jsonl"
+    // returns: nothing
+    void showEvent(const Event&, const string&) const;
+
     // purpose: prints an error to the user saying the shell doesn't understand
     // requires: a string
     // returns: nothing
-    void errorNote(string);
+    void errorNote(string_view);
 
-    // purpose: searches for an event by asking the user for relevant info
-    // requires: optionally a string
+    // purpose: changes the bias, importance, time zone, or repeat rule of
+    //          an event
+    // requires: the id of the event, the field, and the new value
+    // returns: nothing
+    void editEvent(unsigned, const string&, const string&);
+
+    // purpose: searches for an event by asking the user for relevant info,
+    //          with the list unlocked while they answer
+    // requires: the lock on the list, held, and optionally a string
     // returns: the index of the event in the heap
-    int findJSONEvent(string);
+    int findJSONEvent(std::unique_lock<std::mutex>&, string_view);
 
-    // purpose: writes each element of the heap to the json file
+    // purpose: reads the events in the list file, a missing or broken file
+    //          is an empty list
+    // requires: a vector to append the events to
+    // returns: nothing
+    void readListFile(vector<Event>&);
+
+    // purpose: takes the events in the json file and tosses them onto
+    //          the heap, without writing anything
+    // requires: nothing
+    // returns: true if events had to be given new ids, so the file
+    //          is out of date
+    bool JSON2heap();
+
+    // purpose: throws the list away, gives its memory back to the system
+    //          in one go, and reads it from the json file again
     // requires: nothing
     // returns: nothing
-    void heap2JSON();
+    void reload();
 
-    // purpose: takes data from a json file and tosses it onto the heap
-    // requires: an nlohmann::json data type
+    // purpose: adds every event in a csv or json file to the list at once
+    // requires: the name of the file
     // returns: nothing
-    void JSON2heap();
+    void importFile(const string&);
 
-    // purpose: asks the user about the event, and writes it to the json file
-    // requires: nothing
-    // returns: a pointer to the event
-    Event* makeEvent();
+    // purpose: asks the user about the event, with the list unlocked while
+    //          they answer, and makes it
+    // requires: the lock on the list, held
+    // returns: the event
+    Event makeEvent(std::unique_lock<std::mutex>&);
 
-    // purpose: checks if a json entry matches an event
-    // requires: a json entry and an event
-    // returns: a boolean value
-    bool matchesJSONEvent(const json&, const Event&);
-    
     // purpose: separates a string using a delimiter
     // requires: a full command, can take in a delimiter
     // returns: a vector of strings
@@ -162,20 +278,39 @@ private:
     // returns: nothing
     void printEvent(const Event& event) const { cout << event; }
 
-    // purpose: removes an event from the json data
-    // requires: an event
+    // purpose: asks for the whole list to be saved to the json file,
+    //          which happens atomically on the saving thread
+    // requires: nothing
     // returns: nothing
-    void removeEventFromJSON(const Event& event);
+    void writeUpdatedJSON() { saver.request(); }
 
-    // purpose: updates the json file with the json data
-    // requires: nothing
+    // purpose: writes the whole list, called by the saving thread
+    // requires: the stream to the temp file
     // returns: nothing
-    void writeUpdatedJSON();
+    void saveList(std::ostream&);
 
-    // purpose: write an event to the json file
-    // requires: an event
+    // purpose: writes the list store, called by the saving thread
+    //          right after the list file
+    // requires: the stream to the temp file
     // returns: nothing
-    void write2JSON(const Event&);
+    void saveStore(std::ostream&);
+
+    // purpose: has the list store saved along with the list file
+    // requires: nothing
+    // returns: nothing
+    void saveStoreToo()
+    {
+        saver.addFile(storeFile, [this](std::ostream& os) { saveStore(os); });
+    }
+
+    // purpose: determines if the list store is missing or older than the
+    //          list file, so it needs saving even if nothing changed
+    // requires: nothing
+    // returns: true if it's behind
+    bool storeIsBehind() const
+    {
+        return !toDoList.empty() && !storeIsFresh(listFile, storeFile);
+    }
 };
 
 
@@ -185,38 +320,13 @@ private:
 
 // default constructor
 // cowritten by DeepSeek
-Shell::Shell() : ownsHeap(true)
+Shell::Shell() : ownsHeap(true), listFile("to_do_list.json")
 {
-
-    // open the file
-    jsonFile.open("to_do_list.json", std::ios::in | std::ios::out);
-
-    // Create the file if it doesn't exist
-    if (!jsonFile.is_open()) {
-        jsonFile.open("to_do_list.json", std::ios::out);
-        jsonFile << "{ \"to do list\": [] }"; // Initialize with empty array
-        jsonFile.close();
-        jsonFile.open("to_do_list.json", std::ios::in | std::ios::out);
-    }
-
-    // try to get the json data
-    try
-    {
-        jsonData = json::parse(jsonFile);
-    }
-    catch (const json::parse_error&) {
-        // make it if it doesn't work
-        jsonData = json::object();
-        jsonData["to do list"] = json::array(); // Ensure it's an array
-    }
-
-    /*
-    // initialize the heap
-    toDoList = new vector<Event>();
-    */
+    saveStoreToo();
 
     // toss the json values onto the heap
-    JSON2heap();
+    if (JSON2heap() || storeIsBehind())
+        writeUpdatedJSON();
 
     // set the shell running
     is_running = true;
@@ -227,38 +337,13 @@ Shell::Shell() : ownsHeap(true)
 // parametrized constructor
 // cowritten by DeepSeek
 // takes in a file name
-Shell::Shell(string fileName) : ownsHeap(true)
+Shell::Shell(string fileName) : ownsHeap(true), listFile(fileName)
 {
-
-    // open the file
-    jsonFile.open(fileName, std::ios::in | std::ios::out);
-
-    // Create the file if it doesn't exist
-    if (!jsonFile.is_open()) {
-        jsonFile.open(fileName, std::ios::out);
-        jsonFile << "{ \"to do list\": [] }"; // Initialize with empty array
-        jsonFile.close();
-        jsonFile.open(fileName, std::ios::in | std::ios::out);
-    }
-
-    // try to get the json data
-    try
-    {
-        jsonData = json::parse(jsonFile);
-    }
-    catch (const json::parse_error&) {
-        // make it if it doesn't work
-        jsonData = json::object();
-        jsonData["to do list"] = json::array(); // Ensure it's an array
-    }
-
-    /*
-    // initialize the heap
-    toDoList = new vector<Event>();
-    */
+    saveStoreToo();
 
     // write the json data to the heap
-    JSON2heap();
+    if (JSON2heap() || storeIsBehind())
+        writeUpdatedJSON();
     
     // set the shell running
     is_running = true;
@@ -269,48 +354,24 @@ Shell::Shell(string fileName) : ownsHeap(true)
 
 // parametrized constructor
 // cowritten by DeepSeek
-// takes in a file name and a heap
-Shell::Shell(string fileName, vector<Event>& myHeap) : ownsHeap(false)
+// takes in a file name, a heap, and whether the file is saved minified
+Shell::Shell(string fileName, vector<Event>& myHeap, bool minified = false)
+    : ownsHeap(false), listFile(fileName), minifyFile(minified)
 {
-    // open the file
-    jsonFile.open(fileName, std::ios::in | std::ios::out);
-
-    // Create the file if it doesn't exist
-    if (!jsonFile.is_open()) {
-        jsonFile.open(fileName, std::ios::out);
-        jsonFile << "{ \"to do list\": [] }"; // Initialize with empty array
-        jsonFile.close();
-        jsonFile.open(fileName, std::ios::in | std::ios::out);
-    }
-
-    // try to get the json data
-    try
-    {
-        jsonData = json::parse(jsonFile);
-    }
-    catch (const json::parse_error&) {
-        // make it if it doesn't work
-        jsonData = json::object();
-        jsonData["to do list"] = json::array(); // Ensure it's an array
-    }
+    saveStoreToo();
 
     // set the to do list to the heap passed through
     toDoList = myHeap;
+    for (auto &i : toDoList)
+        assignId(i);
 
     // toss all the events already in the json file to the heap
     // since the heap has duplicate checking, this is fine
-    JSON2heap();
-
-    // clear the json file
-    jsonFile.close();
-    jsonFile.open("to_do_list.json", std::ios::out | std::ios::trunc);  // Truncate the file
-    jsonData["to do list"] = json::array();  // Reset in-memory JSON to empty array
-    jsonFile << std::setw(4) << jsonData;    // Write empty array to file
-    jsonFile.close();
-    jsonFile.open("to_do_list.json", std::ios::in | std::ios::out);  // Reopen for operations
+    bool changed = JSON2heap();
 
-    // write each event in the heap to the json file
-    heap2JSON();
+    // only save if there's something the file doesn't have yet
+    if (changed || !myHeap.empty() || storeIsBehind())
+        writeUpdatedJSON();
 
     // set the shell running
     is_running = true;
@@ -321,15 +382,37 @@ Shell::Shell(string fileName, vector<Event>& myHeap) : ownsHeap(false)
 
 // parametrized constructor
 // takes in a file name and an event
-Shell::Shell(string fileName, const Event& myEvent) : ownsHeap(true)
+Shell::Shell(string fileName, const Event& myEvent) : ownsHeap(true),
+    listFile(fileName)
 {
+    saveStoreToo();
+
     is_running = true;
 
-    jsonFile.open(fileName);
+    toDoList.push_back(myEvent);
+    assignId(toDoList.back());
 
-    jsonData = json::parse(jsonFile);
+    printCommands();
+}
 
-    toDoList.push_back(myEvent);
+// parametrized constructor
+// takes in a file name and whether the list can be changed
+Shell::Shell(string fileName, OpenMode mode) : ownsHeap(true),
+    listFile(fileName), readOnly(mode == ReadOnly)
+{
+    if (!readOnly)
+    {
+        saveStoreToo();
+
+        if (JSON2heap() || storeIsBehind())
+            writeUpdatedJSON();
+    }
+    // the store is only as good as the list file it was saved with,
+    // otherwise the list file gets read like always (and isn't written)
+    else if (!storeIsFresh(listFile, storeFile) || !store.open(storeFile))
+        JSON2heap();
+
+    is_running = true;
 
     printCommands();
 }
@@ -337,7 +420,9 @@ Shell::Shell(string fileName, const Event& myEvent) : ownsHeap(true)
 // destructor
 Shell::~Shell()
 {
-    jsonFile.close();
+    // finish saving before the list goes away
+    saver.flush();
+
     if (ownsHeap)
         toDoList.erase(toDoList.begin(), toDoList.end());
 }
@@ -365,9 +450,35 @@ vector<string> Shell::getCommand() const
 // run the command line that is passed through
 void Shell::runCommand(vector<string> cmd_line)
 {
+    std::unique_lock<std::mutex> guard(listMutex);
+    map<string, string> options = extractOptions(cmd_line);
+    string format = options.count("format") ? options["format"] : "text";
     int kw_count = 0;
-    // keywords from the command line
-    string keyword = cmd_line[kw_count];
+
+    // the options can be all there was, and then there's no command to
+    // run
+    if (cmd_line.empty())
+    {
+        if (!options.empty())
+        {
+            cout << "The options need a command\n\n";
+            printCommands();
+        }
+        return;
+    }
+
+    // keywords from the command line, they stay in cmd_line
+    string_view keyword = cmd_line[kw_count];
+
+    // a read-only list can only be looked at
+    if (readOnly && keyword != "help" && keyword != "quit"
+        && keyword != "view")
+    {
+        cout << "The list is open read-only\n";
+        return;
+    }
+
+    catchUpClock();
 
     try
     {
@@ -390,14 +501,16 @@ void Shell::runCommand(vector<string> cmd_line)
             if (keyword == "event")
             {
                 // make one!
-                Event* nEvent = makeEvent();
+                Event nEvent = makeEvent(guard);
+                assignId(nEvent);
 
                 // add it to the heap
-                toDoList.push_back(*nEvent);
-                make_heap(toDoList.begin(), toDoList.end());
+                toDoList.push_back(nEvent);
+                siftUp(toDoList, toDoList.size() - 1);
+                sortedView.insert(nEvent);
 
                 // write it to the json file
-                write2JSON(*nEvent);
+                writeUpdatedJSON();
             }
             else
             {
@@ -406,6 +519,10 @@ void Shell::runCommand(vector<string> cmd_line)
 
         }
 
+        // the mapped store answers views without the list in memory
+        else if (keyword == "view" && store.isOpen())
+            viewStore(cmd_line, options);
+
         // if the keyword is view
         else if (keyword == "view")
         {
@@ -415,13 +532,15 @@ void Shell::runCommand(vector<string> cmd_line)
             // look at the whole list
             if (keyword == "list")
             {
-                for (auto &i : toDoList)
-                    cout << i << '\n';
+                viewList(options);
             }
             // or just the top
             else if (keyword == "top")
             {
-                cout << toDoList[0];
+                if (toDoList.empty())
+                    cout << "The list is empty" << endl;
+                else
+                    showEvent(toDoList[0], format);
             }
             // or let the user pick an event
             else if (keyword == "event")
@@ -431,13 +550,13 @@ void Shell::runCommand(vector<string> cmd_line)
 
                 try
                 {
-                    index = stoi(keyword);
+                    index = stoi(cmd_line[kw_count]);
 
-                    cout << toDoList[index];
+                    showEvent(toDoList[index], format);
                 }
                 catch (const std::invalid_argument& e)
                 {
-                    index = findJSONEvent(keyword);
+                    index = findJSONEvent(guard, keyword);
 
                     cout << e.what() << '\n';
                     if (index == -1)
@@ -446,7 +565,7 @@ void Shell::runCommand(vector<string> cmd_line)
                     }
                     else
                     {
-                        cout << toDoList[index];
+                        showEvent(toDoList[index], format);
                     }
                 }
                 catch (const std::exception& e)
@@ -467,12 +586,27 @@ void Shell::runCommand(vector<string> cmd_line)
         {
             keyword = cmd_line[++kw_count];
 
-            if (keyword == "top")
+            if (keyword == "top" && toDoList.empty())
             {
-                Event topEvent = toDoList[0];
-                pop_heap(toDoList.begin(), toDoList.end());
+                cout << "The list is empty" << endl;
+            }
+            else if (keyword == "top")
+            {
+                sortedView.erase(toDoList[0]);
+
+                // an event that repeats stays in the list, due next time
+                if (toDoList[0].next_occurrence())
+                {
+                    sortedView.insert(toDoList[0]);
+                    fixHeap(toDoList, 0);
+                }
+                else
+                {
+                    pop_heap(toDoList.begin(), toDoList.end());
+                    toDoList.pop_back();
+                }
 
-                removeEventFromJSON(topEvent);
+                writeUpdatedJSON();
             }
             else
             {
@@ -481,6 +615,37 @@ void Shell::runCommand(vector<string> cmd_line)
 
         }
 
+        // if the keyword is reload
+        else if (keyword == "reload")
+        {
+            // changes still waiting to be saved would be lost, and the
+            // saving thread needs the list to save them
+            guard.unlock();
+            bool saved = saver.flush();
+            guard.lock();
+
+            if (saved)
+                reload();
+            else
+                cout << "The list couldn't be saved, so it wasn't reloaded"
+                    << endl;
+        }
+
+        // if the keyword is import
+        else if (keyword == "import")
+        {
+            importFile(cmd_line.at(++kw_count));
+        }
+
+        // if the keyword is edit
+        else if (keyword == "edit")
+        {
+            unsigned id = static_cast<unsigned>(stoul(cmd_line.at(++kw_count)));
+            const string& field = cmd_line.at(++kw_count);
+
+            editEvent(id, field, cmd_line.at(++kw_count));
+        }
+
         // if the user enters an unknown keyword
         else
         {
@@ -496,10 +661,134 @@ void Shell::runCommand(vector<string> cmd_line)
     return;
 }
 
+// apply a batch of commands from the command queue
+void Shell::applyCommands(const vector<Command>& batch)
+{
+    std::lock_guard<std::mutex> guard(listMutex);
+    // how much of the list is still a heap, whether the heap was broken
+    // somewhere in the middle, and whether the file needs writing
+    size_t ordered;
+    bool broken = false;
+    bool changed = false;
+
+    catchUpClock();
+    ordered = toDoList.size();
+
+    for (auto &cmd : batch)
+    {
+        switch (cmd.type)
+        {
+        case Command::Make:
+            // toss it on the end, the heap gets fixed up once at the end
+            toDoList.push_back(cmd.toEvent());
+            assignId(toDoList.back());
+            sortedView.insert(toDoList.back());
+            changed = true;
+            break;
+
+        case Command::Finish:
+        {
+            Symbol symbol = SymbolTable::NONE;
+            std::int32_t minutes = 0;
+
+            // nothing in the list can match
+            if (!cmd.resolve(symbol, minutes))
+                break;
+
+            // swap the match to the back and drop it
+            for (size_t i = 0; i < toDoList.size(); i++)
+            {
+                if (cmd.matches(toDoList[i], symbol, minutes))
+                {
+                    sortedView.erase(toDoList[i]);
+
+                    // an event that repeats moves on instead of going
+                    if (toDoList[i].next_occurrence())
+                        sortedView.insert(toDoList[i]);
+                    else
+                    {
+                        std::swap(toDoList[i], toDoList.back());
+                        toDoList.pop_back();
+                    }
+
+                    broken = changed = true;
+                    break;
+                }
+            }
+            break;
+        }
+
+        case Command::FinishTop:
+            // there's no one at the console to tell, so finishing the top
+            // of an empty list does nothing
+            if (toDoList.empty())
+                break;
+
+            // the top is only known if the heap is in order
+            if (broken)
+                heapify(toDoList);
+            else if (ordered < toDoList.size())
+                restoreHeap(toDoList, ordered);
+            broken = false;
+
+            sortedView.erase(toDoList[0]);
+
+            if (toDoList[0].next_occurrence())
+            {
+                sortedView.insert(toDoList[0]);
+                fixHeap(toDoList, 0);
+            }
+            else
+            {
+                pop_heap(toDoList.begin(), toDoList.end());
+                toDoList.pop_back();
+            }
+
+            ordered = toDoList.size();
+            changed = true;
+            break;
+        }
+    }
+
+    if (broken)
+        heapify(toDoList);
+    else if (ordered < toDoList.size())
+        restoreHeap(toDoList, ordered);
+
+    if (changed)
+        writeUpdatedJSON();
+}
+
         /* private */
 
+// catch the priorities up with the clock
+void Shell::catchUpClock()
+{
+    TimePoint now = currentTime();
+
+    if (now == NOW)
+        return;
+
+    NOW = now;
+
+    for (auto &i : toDoList)
+        i.refresh_priority();
+
+    heapify(toDoList);
+    sortedView.invalidate();
+}
+
+// hand out an id
+void Shell::assignId(Event& event)
+{
+    if (event.get_id() == 0)
+        event.set_id(nextId++);
+    else if (event.get_id() >= nextId)
+        nextId = event.get_id() + 1;
+}
+
 // print an error note to the console
-void Shell::errorNote(string keyword)
+void Shell::errorNote(string_view keyword)
 {
     cout << "\"" << keyword << "\" unknown\n\n";
 
@@ -507,35 +796,88 @@ void Shell::errorNote(string keyword)
 
 }
 
-// write every event of the heap to the json file
-void Shell::heap2JSON()
+// change the bias, importance, time zone, or repeat rule of an event
+void Shell::editEvent(unsigned id, const string& field, const string& value)
 {
     for (size_t i = 0; i < toDoList.size(); i++)
     {
-        write2JSON(toDoList[i]);
+        if (toDoList[i].get_id() != id)
+            continue;
+
+        if (field != "bias" && field != "importance" && field != "zone"
+            && field != "repeat")
+        {
+            errorNote(field);
+            return;
+        }
+
+        // "none" takes the due date out of its zone, or stops it repeating
+        ZoneId zone = field != "zone" || value == "none" ? 0
+            : ZONES.find(value);
+        Recurrence rule;
+
+        if (field == "zone" && value != "none" && zone == 0)
+        {
+            cout << "Time zone " << value << " not found\n";
+            return;
+        }
+
+        if (field == "repeat" && value != "none"
+            && !readRecurrence(value, rule))
+        {
+            cout << "Not a repeat rule: " << value << "\n";
+            return;
+        }
+
+        // take it out of the sorted view with its old priority
+        sortedView.erase(toDoList[i]);
+
+        if (field == "bias")
+            toDoList[i].set_bias(stod(value));
+        else if (field == "importance")
+            toDoList[i].set_importance(stoi(value));
+        else if (field == "zone")
+            toDoList[i].set_zone(zone);
+        else
+            toDoList[i].set_repeat(rule);
+
+        // and put it back where it goes now
+        sortedView.insert(toDoList[i]);
+        fixHeap(toDoList, i);
+
+        writeUpdatedJSON();
+        return;
     }
 
+    cout << "Event " << id << " not found\n";
 }
 
 // find the index of the event in the heap with the user's help
-int Shell::findJSONEvent(string keyword = "")
+int Shell::findJSONEvent(std::unique_lock<std::mutex>& guard,
+    string_view keyword = "")
 {
-    char firstChar = keyword[0];
     size_t choice = 0;
     string title;
     vector<int> indices;
+    vector<unsigned> ids;
 
     if (keyword == "")
     {
-        // get the event name from the user
+        // get the event name from the user, without holding the list up
+        // while they type
+        guard.unlock();
         cout << "Event name:" << endl << ">> ";
         getline(cin, title);
+        guard.lock();
+
+        // names are interned, so compare symbols instead of strings
+        Symbol wanted = TITLES.find(title);
 
         // go through the to do list
         for (size_t i = 0; i < toDoList.size(); i++)
         {
             // mark every event that has the same name as the title
-            if (toDoList[i].get_name() == title)
+            if (toDoList[i].get_title() == wanted)
             {
                 indices.push_back(i);
             }
@@ -552,23 +894,27 @@ int Shell::findJSONEvent(string keyword = "")
         {
             cout << "Multiple events exist with the name \"" << title << "\"\n";
 
-            do
+            // list every event with the same name, and remember them by
+            // id, since the list can change while the user picks one
+            for (size_t i = 0; i < indices.size(); ++i)
             {
-                // list every event with the same name
-                for (size_t i = 0; i < indices.size(); ++i)
-                {
-                    cout << i + 1 << "\n";
-                    cout << toDoList[indices[i]].get_name() << "\n\t";
-                    cout << toDoList[indices[i]].get_description();
-                    cout << "\n";
-                }
+                cout << i + 1 << "\n";
+                cout << toDoList[indices[i]].get_name() << "\n\t";
+                cout << toDoList[indices[i]].get_description();
+                cout << "\n";
+                ids.push_back(toDoList[indices[i]].get_id());
+            }
 
+            guard.unlock();
+
+            do
+            {
                 // prompt the user for the event
                 cout << "Choose the event\n>> ";
                 cin >> choice;
 
                 // if the choice is invalid
-                if (choice <= 0 || choice > indices.size())
+                if (choice <= 0 || choice > ids.size())
                 {
                     cout << "\nInvalid input\n";
                 }
@@ -576,10 +922,16 @@ int Shell::findJSONEvent(string keyword = "")
                 cin.ignore();
 
                 // repeat
-            } while (choice <= 0 || choice > indices.size());
+            } while (choice <= 0 || choice > ids.size());
+
+            guard.lock();
 
-            // return the index and make sure there's no overflow
-            return indices[choice - 1];
+            // the event might have been finished in the meantime
+            for (size_t i = 0; i < toDoList.size(); i++)
+                if (toDoList[i].get_id() == ids[choice - 1])
+                    return i;
+
+            return -1;
         }
 
         return indices[0];
@@ -589,68 +941,166 @@ int Shell::findJSONEvent(string keyword = "")
 }
 
 // pushes all the json data onto the heap
-void Shell::JSON2heap()
+bool Shell::JSON2heap()
 {
-    for (auto &i : jsonData["to do list"])
+    vector<Event> batch;
+    std::unordered_set<unsigned> seen;
+    bool renumbered = false;
+
+    // the events are keyed from the clock's time as of the load
+    catchUpClock();
+
+    for (auto &i : toDoList)
+        seen.insert(i.get_id());
+
+    // the events are made right in the batch, their strings go in the arena
+    readListFile(batch);
+
+    // keep the id each was saved with, unless another event has it
+    for (auto &i : batch)
+        if (i.get_id() != 0 && !seen.insert(i.get_id()).second)
+            i.set_id(0);
+
+    // skip past the saved ids before handing out new ones
+    for (auto &i : batch)
+        if (i.get_id() != 0)
+            assignId(i);
+
+    // the new ids get saved with the next write
+    for (auto &i : batch)
     {
-        Event* temp;
+        if (i.get_id() == 0)
+        {
+            assignId(i);
+            renumbered = true;
+        }
+    }
 
-        // get and set the time
-        TimePoint* time = new TimePoint(i["due_date"]["year"],
-            stom(i["due_date"]["month"]), i["due_date"]["day"],
-            i["due_date"]["hour"], i["due_date"]["minute"]);
+    // put the whole batch on the heap with one heapify
+    bulkIngest(toDoList, std::move(batch));
+    sortedView.invalidate();
 
-        // make the event
-        temp = new Event( i["title"], *time,
-            static_cast<unsigned short>( i["importance"] ),
-            static_cast<double>( i["bias"] ), i["description"]);
+    return renumbered;
+}
 
-        // toss the event on the to do list
-        toDoList.push_back(*temp);
-        
+// read the list from the file again
+void Shell::reload()
+{
+    toDoList.clear();
+    sortedView.invalidate();
+
+    // nothing points into the arena anymore
+    LIST_ARENA.reset();
+    TITLES.reset();
+    DESCRIPTIONS.reset();
+    SCHEDULES.reset();
+
+    nextId = 1;
+    if (JSON2heap())
+        writeUpdatedJSON();
+
+    cout << "Reloaded " << toDoList.size() << " events\n";
+}
+
+// import events from a csv or json file
+void Shell::importFile(const string& fileName)
+{
+    std::ifstream in(fileName);
+    vector<Event> batch;
+
+    if (!in.is_open())
+    {
+        cout << "Couldn't open \"" << fileName << "\"\n";
+        return;
     }
-    push_heap(toDoList.begin(), toDoList.end());
+
+    // csv files go by their extension, everything else is json
+    if (fileName.size() > 4
+        && fileName.compare(fileName.size() - 4, 4, ".csv") == 0)
+        readCSVEvents(in, batch);
+    else
+    {
+        string text;
+
+        readFileText(fileName, text);
+
+        if (!readListEventsParallel(text, batch))
+            throw std::invalid_argument("\"" + fileName
+                + "\" isn't a to do list");
+    }
+
+    // imported events always get new ids, theirs belong to another list
+    for (auto &i : batch)
+    {
+        i.set_id(0);
+        assignId(i);
+    }
+
+    cout << "Imported " << batch.size() << " events\n";
+
+    bulkIngest(toDoList, std::move(batch));
+    sortedView.invalidate();
+
+    writeUpdatedJSON();
 }
 
 // prompts the user for event info and returns such an event
-Event* Shell::makeEvent()
+Event Shell::makeEvent(std::unique_lock<std::mutex>& guard)
 {
     double bias;
-    Event* nEvent;
     int days;
     int hour;
     int minute;
     int year;
     Months month;
     string title;
-    TimePoint* time;
     unsigned short importance;
 
-    // ask the user for the relevant info
+    // ask the user for the relevant info, without holding the list up
+    // while they type
+    guard.unlock();
     readEventInfo(title, year, month, days, hour, minute, importance, bias);
+    guard.lock();
 
-    // create the time
-    time = new TimePoint(year, month, days, hour, minute);
+    // create the event, its strings go in the list arena
+    return Event(title, TimePoint(year, month, days, hour, minute),
+        importance, bias);
+}
 
-    // create the event
-    nEvent = new Event(title, *time, importance, bias);
+// pull the options out of the command line
+map<string, string> Shell::extractOptions(vector<string>& cmd_line) const
+{
+    map<string, string> options;
+    size_t kept = 0;
 
-    return nEvent;
-}
+    for (size_t i = 0; i < cmd_line.size(); i++)
+    {
+        // everything that isn't an option stays a keyword,
+        // slid down in place over the options before it
+        if (cmd_line[i].compare(0, 2, "--") != 0)
+        {
+            if (kept != i)
+                cmd_line[kept] = std::move(cmd_line[i]);
+            kept++;
+            continue;
+        }
+
+        string name = cmd_line[i].substr(2);
+        size_t equals = name.find('=');
+
+        // --name=value
+        if (equals != string::npos)
+            options[name.substr(0, equals)] = name.substr(equals + 1);
+        // --name value
+        else if (i + 1 < cmd_line.size())
+            options[name] = cmd_line[++i];
+        else
+            options[name] = "";
+    }
 
-// written by DeepSeek
-bool Shell::matchesJSONEvent(const json& eventJson, const Event& event) {
-    // Compare all fields
-    return (
-        eventJson["title"] == event.get_name() &&
-        eventJson["importance"] == event.get_importance() &&
-        eventJson["bias"] == event.get_bias() &&
-        eventJson["due_date"]["year"] == event.get_due_date().year &&
-        eventJson["due_date"]["month"] == mtos(event.get_due_date().month) &&
-        eventJson["due_date"]["day"] == event.get_due_date().day &&
-        eventJson["due_date"]["hour"] == event.get_due_date().hour &&
-        eventJson["due_date"]["minute"] == event.get_due_date().minute
-        );
+    cmd_line.resize(kept);
+
+    return options;
 }
 
 // parses the command
@@ -692,70 +1142,204 @@ void Shell::printCommands() const
     cout << "quit\n\tTurn off the shell\n";
     cout << "make [object]\n\tMake the object passed through\n";
     cout << "view [object]\n\tView he object passed through\n";
-    cout << "finish [object]\n\tRemove the object from the list\n";
+    cout << "finish [object]\n\tRemove the object from the list, an event"
+        " that repeats moves on to\n\tits next time instead\n";
+    cout << "edit [id] [bias|importance|zone|repeat] [value]\n\tChange an"
+        " event, a zone is like Europe/Paris, a repeat is daily, weekly,\n\t"
+        "monthly, yearly, or like FREQ=MONTHLY;BYDAY=-1FR, and either can"
+        " be none\n";
+    cout << "import [file]\n\tAdd every event in a .csv or .json file\n";
+    cout << "reload\n\tRead the list from the file again\n";
     
     cout << "\n\t-- Objects --\n";
     cout << "list\n\tThe To Do List itself\n";
     cout << "top\n\tThe most important Event in the list\n";
     cout << "event\n\tA specific Event\n";
+
+    cout << "\n\t-- Options --\n";
+    cout << "--format=jsonl\n\tView events as one json object per line\n";
+    cout << "--limit N\n\tView at most N events of the list\n";
+    cout << "--after ID\n\tView the list from after the event with that id\n";
 }
 
-// written by DeepSeek
-// removes an event from the json data
-void Shell::removeEventFromJSON(const Event& event) {
-    // Get the "to do list" array reference
-    auto& todoArray = jsonData["to do list"];
-
-    // Iterate through the JSON array
-    for (auto it = todoArray.begin(); it != todoArray.end(); ++it) {
-        if (matchesJSONEvent(*it, event)) {
-            // Erase the matching element
-            todoArray.erase(it);
-            break; // Exit after first match
+// print a page of the list
+void Shell::viewList(map<string, string>& options)
+{
+    size_t start = 0;
+    size_t stop;
+
+    // only sort from scratch when the priorities have moved
+    if (sortedView.needsRebuild(NOW))
+        sortedView.rebuild(toDoList, NOW);
+
+    stop = sortedView.size();
+
+    // start right after the last event of the previous page
+    if (options.count("after"))
+    {
+        start = sortedView.positionAfter(
+            static_cast<unsigned>(std::stoul(options["after"])));
+
+        if (start == SortedView::npos)
+        {
+            cout << "Event " << options["after"] << " not found\n";
+            return;
         }
     }
 
-    // Write changes back to the file
-    writeUpdatedJSON();
+    if (options.count("limit"))
+    {
+        int limit = std::stoi(options["limit"]);
+
+        if (limit < 0)
+            throw std::invalid_argument("The limit can't be negative");
+
+        stop = std::min(stop, start + static_cast<size_t>(limit));
+    }
+
+    if (options["format"] == "jsonl")
+        writeJSONLines(cout, sortedView.at(start), sortedView.at(stop));
+    else
+    {
+        writeList(cout, sortedView.at(start), sortedView.at(stop));
+
+        // tell the user how to get the next page
+        if (stop < sortedView.size() && stop > start)
+            cout << "-- more: --after " << sortedView.at(stop - 1)->get_id()
+                << " --\n";
+    }
+}
+
+// answer a view from the list store
+void Shell::viewStore(const vector<string>& cmd_line,
+    map<string, string>& options)
+{
+    string format = options.count("format") ? options["format"] : "text";
+    string_view keyword = cmd_line.at(1);
+    vector<Event> page;
+
+    // the events are only built to be printed, so the ones from the last
+    // view can go
+    LIST_ARENA.reset();
+    TITLES.reset();
+    DESCRIPTIONS.reset();
+    SCHEDULES.reset();
+
+    // a page of the list, like viewList but in the saved order
+    if (keyword == "list")
+    {
+        size_t start = 0;
+        size_t stop = store.size();
+
+        if (options.count("after"))
+        {
+            start = store.rankAfter(
+                static_cast<unsigned>(std::stoul(options["after"])));
+
+            if (start == ListStore::npos)
+            {
+                cout << "Event " << options["after"] << " not found\n";
+                return;
+            }
+        }
+
+        if (options.count("limit"))
+        {
+            int limit = std::stoi(options["limit"]);
+
+            if (limit < 0)
+                throw std::invalid_argument("The limit can't be negative");
+
+            stop = std::min(stop, start + static_cast<size_t>(limit));
+        }
+
+        page.reserve(stop - start);
+        for (size_t i = start; i < stop; i++)
+            page.push_back(store.event(store.ranked(i)));
+
+        if (format == "jsonl")
+            writeJSONLines(cout, page);
+        else
+        {
+            writeList(cout, page);
+
+            if (stop < store.size() && stop > start)
+                cout << "-- more: --after " << store.ranked(stop - 1).id
+                    << " --\n";
+        }
+    }
+    // the top of the heap is the first record
+    else if (keyword == "top")
+    {
+        if (store.size() == 0)
+            cout << "The list is empty" << endl;
+        else
+            showEvent(store.event(store.record(0)), format);
+    }
+    // an event by its place in the heap, or by its title
+    else if (keyword == "event")
+    {
+        const string& which = cmd_line.at(2);
+        size_t index;
+
+        try
+        {
+            index = std::stoul(which);
+        }
+        catch (const std::invalid_argument&)
+        {
+            index = store.findTitle(which);
+        }
+
+        if (index == ListStore::npos)
+            cout << "Event not found" << endl;
+        else
+            showEvent(store.event(store.record(index)), format);
+    }
+    else
+    {
+        errorNote(keyword);
+    }
 }
 
-// written by DeepSeek
-// writes the json data to the file
-void Shell::writeUpdatedJSON() {
-    jsonFile.close();
-    jsonFile.open("to_do_list.json", std::ios::out | std::ios::trunc);
-    jsonFile << std::setw(4) << jsonData << endl;
-    jsonFile.close();
-    jsonFile.open("to_do_list.json", std::ios::in | std::ios::out);
+// print an event as text or as a json line
+void Shell::showEvent(const Event& event, const string& format) const
+{
+    if (format == "jsonl")
+        writeJSONLine(cout, event);
+    else
+        printEvent(event);
 }
 
-// cowritten by DeepSeek
-// write an event to the json file
-void Shell::write2JSON(const Event& event)
+// read the list file
+void Shell::readListFile(vector<Event>& batch)
+{
+    string text;
+
+    // the file gets made by the first save
+    if (!readFileText(listFile, text))
+        return;
+
+    if (!readListEventsParallel(text, batch))
+        cout << "\"" << listFile << "\" couldn't be read, "
+            << "starting with an empty list\n";
+}
+
+// write the list for the saving thread
+void Shell::saveList(std::ostream& os)
 {
-    json eventJson;
-    eventJson["title"] = event.get_name();
-    eventJson["importance"] = event.get_importance();
-    eventJson["bias"] = event.get_bias();
-    eventJson["description"] = event.get_description();
-
-    TimePoint dueDate = event.get_due_date();
-    eventJson["due_date"]["year"] = dueDate.year;
-    eventJson["due_date"]["month"] = mtos(dueDate.month);
-    eventJson["due_date"]["day"] = dueDate.day;
-    eventJson["due_date"]["hour"] = dueDate.hour;
-    eventJson["due_date"]["minute"] = dueDate.minute;
-
-    // Append the new event to the "to do list" array
-    jsonData["to do list"].push_back(eventJson);
-
-    // Write the updated JSON back to the file
-    jsonFile.close();
-    jsonFile.open("to_do_list.json", std::ios::out | std::ios::trunc);
-    jsonFile << std::setw(4) << jsonData << endl;
-    jsonFile.close();
-    // Reopen for subsequent operations
-    jsonFile.open("to_do_list.json", std::ios::in | std::ios::out);
+    std::lock_guard<std::mutex> guard(listMutex);
+
+    // the events are the list, so they're streamed out as they are
+    writeListJSON(os, toDoList, minifyFile);
+}
+
+// write the list store for the saving thread
+void Shell::saveStore(std::ostream& os)
+{
+    std::lock_guard<std::mutex> guard(listMutex);
+
+    writeListStore(os, toDoList);
 }
 
 
@@ -0,0 +1,117 @@
+// includes
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "../event/event.hpp"
+#include "../memory/arena.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+
+// an event keeps its strings in the list arena and its due date inline,
+// so it copies without allocating
+static_assert(std::is_trivially_copyable<Event>::value,
+    "events copy without allocating");
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// memory comes out aligned, one allocation after another in a block
+void testAllocate()
+{
+    Arena arena;
+
+    CHECK(arena.bytesUsed() == 0 && arena.bytesReserved() == 0);
+
+    char* first = static_cast<char*>(arena.allocate(3, 1));
+    void* aligned = arena.allocate(8, 8);
+    char* next = static_cast<char*>(arena.allocate(1, 1));
+
+    CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 8 == 0);
+    CHECK(next == static_cast<char*>(aligned) + 8);
+    CHECK(next - first <= 16);
+    CHECK(arena.bytesUsed() == 12);
+    CHECK(arena.bytesReserved() == ARENA_BLOCK_SIZE);
+}
+
+// stored strings are copies that stay put while more are added, and a
+// string bigger than a block gets one of its own
+void testStore()
+{
+    Arena arena;
+    string text = "pay rent";
+    string_view copy = arena.store(text);
+    string big(3 * ARENA_BLOCK_SIZE, 'x');
+
+    text[0] = 'P';
+    CHECK(copy == "pay rent");
+    CHECK(copy.data() != text.data());
+    CHECK(arena.store("").empty());
+
+    for (int i = 0; i < 10000; i++)
+        arena.store("filler " + std::to_string(i));
+
+    string_view bigCopy = arena.store(big);
+
+    CHECK(copy == "pay rent");
+    CHECK(bigCopy == big);
+    CHECK(arena.bytesReserved() >= 4 * ARENA_BLOCK_SIZE);
+}
+
+// a reset gives everything back but the first block, which the next
+// round reuses
+void testReset()
+{
+    Arena arena;
+    string_view first = arena.store("first");
+
+    for (int i = 0; i < 20000; i++)
+        arena.store("filler " + std::to_string(i));
+
+    CHECK(arena.bytesReserved() > ARENA_BLOCK_SIZE);
+
+    arena.reset();
+    CHECK(arena.bytesUsed() == 0);
+    CHECK(arena.bytesReserved() == ARENA_BLOCK_SIZE);
+    CHECK(arena.store("again").data() == first.data());
+}
+
+// events built from temporary strings keep their own copies in the list
+// arena
+void testEvents()
+{
+    size_t before = LIST_ARENA.bytesUsed();
+    Event copy;
+
+    {
+        string title = "water the plants";
+        string description = "the ones by the window";
+        Event event(title, TimePoint(2023, Months::May, 1, 9, 30), 2, 0.0,
+            description);
+
+        copy = event;
+        title.assign(title.size(), '?');
+        description.assign(description.size(), '?');
+    }
+
+    CHECK(copy.get_name() == "water the plants");
+    CHECK(copy.get_description() == "the ones by the window");
+    CHECK(copy.get_due_date() == TimePoint(2023, Months::May, 1, 9, 30));
+    CHECK(LIST_ARENA.bytesUsed() > before);
+}
+
+int main()
+{
+    testAllocate();
+    testStore();
+    testReset();
+    testEvents();
+
+    return testResult("arena");
+}
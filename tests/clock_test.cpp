@@ -0,0 +1,109 @@
+// includes
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include "../event/clock.hpp"
+#include "../event/event.hpp"
+#include "test.hpp"
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// a fixed clock only moves when it's told to
+void testFixedClock()
+{
+    TimePoint start(2023, Months::March, 31, 23, 30);
+    FixedClock clock(start);
+
+    CHECK(clock.now() == start);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(clock.now() == start);
+
+    clock.advance(45);
+    CHECK(clock.now() == TimePoint(2023, Months::April, 1, 0, 15));
+    clock.advance(-45);
+    CHECK(clock.now() == start);
+
+    clock.set(TimePoint(2024, Months::February, 29, 12, 0));
+    CHECK(clock.now() == TimePoint(2024, Months::February, 29, 12, 0));
+}
+
+// a simulated clock runs from its start at its own speed, and can be
+// jumped on top of that
+void testSimulatedClock()
+{
+    TimePoint start(2023, Months::March, 1, 9, 0);
+    // a day goes by every real second
+    SimulatedClock fast(start, 24 * 60 * 60);
+    SimulatedClock stopped(start, 0.0);
+    auto began = std::chrono::steady_clock::now();
+
+    CHECK(fast.speed() == 24 * 60 * 60);
+    CHECK(fast.now() - start < 24);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // at least 100 milliseconds is at least 144 minutes
+    long long real = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - began).count();
+    long long minutes = fast.now().toMinutes() - start.toMinutes();
+
+    CHECK(minutes >= 144);
+    CHECK(minutes <= (real + 10) * 24 * 60 / 1000);
+
+    stopped.advance(60 * 24 * 7);
+    CHECK(stopped.now() == TimePoint(2023, Months::March, 8, 9, 0));
+}
+
+// everything reads the time from whichever clock is in use
+void testUseClock()
+{
+    FixedClock pinned(TimePoint(2030, Months::June, 15, 8, 45));
+    TimePoint system = SYSTEM_CLOCK.now();
+
+    CHECK(system.year >= 2020);
+    CHECK(currentTime() - system < 1);
+
+    useClock(pinned);
+    CHECK(currentTime() == TimePoint(2030, Months::June, 15, 8, 45));
+    pinned.advance(15);
+    CHECK(currentTime() == TimePoint(2030, Months::June, 15, 9, 0));
+
+    useClock(SYSTEM_CLOCK);
+    CHECK(currentTime() - system < 1);
+}
+
+// --now takes a due date the way the shell reads one, and nothing else
+void testStartTime()
+{
+    bool thrown = false;
+
+    CHECK(parseDueDate("2023-06-30 17:00")
+        == TimePoint(2023, Months::June, 30, 17, 0));
+    CHECK(parseDueDate("06 30 2023 17 00")
+        == TimePoint(2023, Months::June, 30, 17, 0));
+
+    try
+    {
+        parseDueDate("tomorrow");
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+}
+
+int main()
+{
+    testFixedClock();
+    testSimulatedClock();
+    testUseClock();
+    testStartTime();
+
+    return testResult("clock");
+}
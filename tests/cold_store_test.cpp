@@ -0,0 +1,76 @@
+// includes
+
+#include <string>
+#include "../event/event.hpp"
+#include "../memory/cold_store.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// every text gets a slot of its own, and empty text is never stored
+void testStore()
+{
+    ColdStore store;
+    string text = "before the 1st";
+    ColdStore::Slot first = store.store(text);
+    ColdStore::Slot again = store.store(text);
+
+    text[0] = 'B';
+
+    CHECK(store.store("") == ColdStore::EMPTY);
+    CHECK(store.get(ColdStore::EMPTY).empty());
+    CHECK(first != ColdStore::EMPTY && again != first);
+    CHECK(store.get(first) == "before the 1st");
+    CHECK(store.get(again) == "before the 1st");
+    CHECK(store.size() == 2);
+    CHECK(store.bytesUsed() == 2 * text.size());
+}
+
+// a reset forgets every slot, and hands them out from the start again
+void testReset()
+{
+    ColdStore store;
+    ColdStore::Slot first = store.store("one");
+
+    store.store("two");
+    store.reset();
+
+    CHECK(store.size() == 0);
+    CHECK(store.bytesUsed() == 0);
+    CHECK(store.store("three") == first);
+    CHECK(store.get(first) == "three");
+}
+
+// an event's description goes in the cold store, not the list arena
+// with the titles
+void testEventDescriptions()
+{
+    string description(1000, 'd');
+    size_t hot = LIST_ARENA.bytesUsed();
+    size_t cold = DESCRIPTIONS.bytesUsed();
+    Event event("cold store test", TimePoint(2023, Months::May, 1, 9, 30),
+        1, 0.0, description);
+    Event blank("cold store test", TimePoint(2023, Months::May, 1, 9, 30));
+
+    CHECK(event.get_description() == description);
+    CHECK(blank.get_description().empty());
+    CHECK(DESCRIPTIONS.bytesUsed() == cold + description.size());
+    CHECK(LIST_ARENA.bytesUsed() - hot < description.size());
+}
+
+int main()
+{
+    testStore();
+    testReset();
+    testEventDescriptions();
+
+    return testResult("cold_store");
+}
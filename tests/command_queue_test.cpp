@@ -0,0 +1,174 @@
+// includes
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../ingest/command_queue.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// how many threads push, and how much each pushes
+constexpr unsigned PRODUCERS = 4;
+constexpr std::uint64_t PUSHES = 200000;
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// the ring rounds up to a power of two, fills up, and hands things back
+// oldest first
+void testSingleThread()
+{
+    RingBuffer<int> ring(5);
+    vector<int> batch;
+    int value = 0;
+    bool thrown = false;
+
+    CHECK(ring.capacity() == 8);
+    CHECK(!ring.tryPop(value));
+
+    for (int i = 0; i < 8; i++)
+        CHECK(ring.tryPush(i));
+    CHECK(!ring.tryPush(8));
+
+    CHECK(ring.tryPop(value) && value == 0);
+    CHECK(ring.tryPush(8));
+    CHECK(ring.popBatch(batch, 5) == 5);
+    CHECK(ring.popBatch(batch, 100) == 3);
+    CHECK(ring.popBatch(batch, 100) == 0);
+
+    for (int i = 0; i < 8; i++)
+        CHECK(batch[i] == i + 1);
+
+    try
+    {
+        RingBuffer<int> tiny(1);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+}
+
+// with several producers pushing at once, the consumer gets everything
+// exactly once, and each producer's in the order it pushed
+void testProducersConsumer()
+{
+    RingBuffer<std::uint64_t> ring(64);
+    vector<std::thread> producers;
+    vector<std::uint64_t> next(PRODUCERS, 0);
+    vector<std::uint64_t> batch;
+    std::uint64_t received = 0;
+    bool ordered = true;
+
+    for (unsigned p = 0; p < PRODUCERS; p++)
+    {
+        producers.emplace_back([&ring, p]()
+        {
+            for (std::uint64_t i = 0; i < PUSHES; i++)
+                while (!ring.tryPush(i * PRODUCERS + p))
+                    std::this_thread::yield();
+        });
+    }
+
+    while (received < PRODUCERS * PUSHES)
+    {
+        batch.clear();
+        if (ring.popBatch(batch, 32) == 0)
+            std::this_thread::yield();
+
+        for (auto i : batch)
+        {
+            ordered = ordered && i / PRODUCERS == next[i % PRODUCERS];
+            next[i % PRODUCERS]++;
+        }
+        received += batch.size();
+    }
+
+    for (auto &i : producers)
+        i.join();
+
+    CHECK(ordered);
+    CHECK(ring.popBatch(batch, 1) == 0);
+
+    for (auto i : next)
+        CHECK(i == PUSHES);
+}
+
+// commands keep their strings and event through the ring, and a blank
+// one doesn't need the clock
+void testCommands()
+{
+    CommandQueue queue(4);
+    Command make;
+    Command popped;
+
+    CHECK(Command().due == TimePoint(1970, Months::January, 1, 0, 0));
+
+    make.title = "pay rent";
+    make.description = "before the 1st";
+    make.due = TimePoint(2023, Months::June, 30, 17, 0);
+    make.importance = 3;
+    make.bias = 0.5;
+
+    CHECK(queue.tryPush(make));
+    CHECK(queue.tryPop(popped));
+    CHECK(popped.type == Command::Make);
+    CHECK(popped.matches(popped.toEvent()));
+    CHECK(popped.toEvent().get_due_date() == make.due);
+}
+
+// a command is looked up once, then matched against events without
+// looking anything up again
+void testResolve()
+{
+    Command finish;
+    Symbol symbol = SymbolTable::NONE;
+    std::int32_t minutes = 0;
+
+    finish.type = Command::Finish;
+    finish.title = "water the plants";
+    finish.due = TimePoint(2023, Months::July, 4, 9, 0);
+
+    // a title no event has ever used can't match anything
+    CHECK(!finish.resolve(symbol, minutes));
+
+    Event event = finish.toEvent();
+    Event other(finish.title, TimePoint(2023, Months::July, 5, 9, 0));
+
+    CHECK(finish.resolve(symbol, minutes));
+    CHECK(symbol == event.get_title());
+    CHECK(minutes == event.get_due_minutes());
+    CHECK(finish.matches(event, symbol, minutes));
+    CHECK(!finish.matches(other, symbol, minutes));
+    CHECK(finish.matches(event));
+    CHECK(!finish.matches(other));
+
+    // neither can a date too far off to store
+    finish.due = TimePoint(9999, Months::July, 4, 9, 0);
+    CHECK(!finish.resolve(symbol, minutes));
+    CHECK(!finish.matches(event));
+}
+
+int main()
+{
+    testSingleThread();
+    testProducersConsumer();
+    testCommands();
+    testResolve();
+
+    return testResult("command_queue");
+}
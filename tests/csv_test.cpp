@@ -0,0 +1,94 @@
+// includes
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../io/csv.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// quoted fields keep their commas, and a doubled quote is a quote
+void testSplit()
+{
+    vector<string> fields;
+
+    splitCSVLine("a,b,,c", fields);
+    CHECK(fields == vector<string>({ "a", "b", "", "c" }));
+
+    splitCSVLine("\"pay, then file\",\"say \"\"hi\"\"\",3\r", fields);
+    CHECK(fields == vector<string>({ "pay, then file", "say \"hi\"", "3" }));
+
+    splitCSVLine("", fields);
+    CHECK(fields == vector<string>({ "" }));
+}
+
+// every line is an event, the header and blank lines aren't
+void testRead()
+{
+    std::istringstream in("title,description,importance,bias,due\r\n"
+        "pay rent,\"before the 1st, or else\",3,0.5,06 30 2023 17 00\r\n"
+        "\r\n"
+        "dentist,,1,0,2023-07-04 09:30\n");
+    vector<Event> events;
+
+    CHECK(readCSVEvents(in, events) == 2);
+    CHECK(events.size() == 2);
+
+    if (events.size() != 2)
+        return;
+
+    CHECK(events[0].get_name() == "pay rent");
+    CHECK(events[0].get_description() == "before the 1st, or else");
+    CHECK(events[0].get_importance() == 3);
+    CHECK(events[0].get_bias() == 0.5);
+    CHECK(events[0].get_due_date()
+        == TimePoint(2023, Months::June, 30, 17, 0));
+    CHECK(events[1].get_description().empty());
+    CHECK(events[1].get_due_date()
+        == TimePoint(2023, Months::July, 4, 9, 30));
+}
+
+// a line with the wrong number of columns, or a due date that isn't one,
+// stops the read
+void testMalformed()
+{
+    for (const char* text : { "pay rent,3,0.5,06 30 2023 17 00\n",
+        "pay rent,,3,0.5,the 30th\n" })
+    {
+        std::istringstream in(text);
+        vector<Event> events;
+        bool thrown = false;
+
+        try
+        {
+            readCSVEvents(in, events);
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+
+        CHECK(thrown);
+        CHECK(events.empty());
+    }
+}
+
+int main()
+{
+    testSplit();
+    testRead();
+    testMalformed();
+
+    return testResult("csv");
+}
@@ -0,0 +1,157 @@
+// includes
+
+#include <climits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "../event/event.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: writes a time point with one of its formatters
+// requires: the time point and whether to write iso 8601
+// returns: the text
+string text(const TimePoint&, bool iso);
+
+// purpose: determines if a due date is turned down
+// requires: the text
+// returns: true if parseDueDate throws invalid_argument
+bool rejected(string_view);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// every minute a date can be unpacks and packs to itself, and reads back
+// from what it's written as
+void testRoundTrip()
+{
+    bool same = true;
+
+    // a step that's prime lands on every hour, day, and month over time
+    for (long long m = -40000000; m < 80000000; m += 7919)
+    {
+        TimePoint point = TimePoint::fromMinutes(m);
+        std::ostringstream fields;
+
+        fields << static_cast<int>(point.month) << ' ' << point.day << ' '
+            << point.year << ' ' << point.hour << ' ' << point.minute;
+
+        same = same && point.toMinutes() == m
+            && parseDueDate(text(point, true)) == point
+            && parseDueDate(fields.str()) == point;
+    }
+
+    CHECK(same);
+}
+
+// each form of due date the shell takes means the same thing
+void testForms()
+{
+    TimePoint leap(2024, Months::February, 29, 7, 5);
+    TimePoint noon(2024, Months::February, 29, 12, 0);
+    std::ostringstream shown;
+
+    CHECK(parseDueDate("02 29 2024 07 05") == leap);
+    CHECK(parseDueDate("2/29/2024 7 5") == leap);
+    CHECK(parseDueDate("02/29/2024/07/05") == leap);
+    CHECK(parseDueDate("2024-02-29T07:05") == leap);
+    CHECK(parseDueDate("2024-02-29 07:05:59") == leap);
+    CHECK(parseDueDate(" \t2024-02-29T07:05\r") == leap);
+    CHECK(parseDueDate("2024-02-29") == noon);
+
+    CHECK(text(leap, false) == "2024/02/29 0705");
+    CHECK(text(leap, true) == "2024-02-29T07:05");
+    shown << leap;
+    CHECK(shown.str() == text(leap, false));
+
+    int y, mon, d, h, min;
+
+    formatDate("12 31 1999 23 59", y, mon, d, h, min);
+    CHECK(y == 1999 && mon == 12 && d == 31 && h == 23 && min == 59);
+}
+
+// dates and times that don't exist, or aren't written right, are turned
+// down
+void testRejected()
+{
+    for (string_view i : { "", "abc", "2023-02-29", "2100-02-29",
+        "13 01 2023 10 00", "00 01 2023 10 00", "02 30 2023 10 00",
+        "01 01 2023 10", "01 01 2023 10 00 extra", "2023-01-01T24:00",
+        "2023-01-01T10:60", "2023-1-1", "2024-02-29T07", "2024-02-29T",
+        "01 01 2023 -1 00" })
+        CHECK(rejected(i));
+
+    CHECK(!rejected("2000-02-29"));
+}
+
+// an event keeps its due date as 32 bits of minutes, and says so when a
+// date won't fit
+void testPacking()
+{
+    TimePoint far(9999, Months::December, 31, 23, 59);
+    bool thrown = false;
+
+    CHECK(packDueDate(TimePoint::fromMinutes(INT32_MAX)) == INT32_MAX);
+    CHECK(packDueDate(TimePoint::fromMinutes(INT32_MIN)) == INT32_MIN);
+
+    try
+    {
+        packDueDate(far);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// write a time point
+string text(const TimePoint& point, bool iso)
+{
+    char buffer[TIME_POINT_TEXT_SIZE];
+
+    return string(buffer, iso ? point.formatISO(buffer)
+        : point.format(buffer));
+}
+
+// is a due date turned down
+bool rejected(string_view date)
+{
+    try
+    {
+        parseDueDate(date);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+int main()
+{
+    testRoundTrip();
+    testForms();
+    testRejected();
+    testPacking();
+
+    return testResult("due_date");
+}
@@ -0,0 +1,275 @@
+// includes
+
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "../io/durable_file.hpp"
+#include "../io/group_commit.hpp"
+#include "test.hpp"
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+
+// usings
+
+using std::string;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the files the test saves, next to it
+const string SAVED_FILE = "durable_test.txt";
+const string SECOND_FILE = "durable_test_second.txt";
+// a directory that's only there part of the time, so saves into it fail
+const string LATER_DIRECTORY = "durable_test_later";
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: reads a whole file
+// requires: its path
+// returns: the text, empty if it isn't there
+string readFile(const string&);
+
+// purpose: determines if a file is there
+// requires: its path
+// returns: a boolean
+bool exists(const string&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// a save either happens whole or leaves the old file alone
+void testAtomicWrite()
+{
+    bool thrown = false;
+
+    writeFileAtomically(SAVED_FILE, [](std::ostream& os) { os << "old"; });
+    CHECK(readFile(SAVED_FILE) == "old");
+    CHECK(!exists(SAVED_FILE + ".tmp"));
+
+    // the writer dying halfway through
+    try
+    {
+        writeFileAtomically(SAVED_FILE, [](std::ostream& os)
+        {
+            os << "half of the new";
+            throw std::runtime_error("crash");
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+    CHECK(readFile(SAVED_FILE) == "old");
+    CHECK(!exists(SAVED_FILE + ".tmp"));
+
+    // the rename failing, over a directory
+    thrown = false;
+    std::filesystem::create_directory(LATER_DIRECTORY);
+    try
+    {
+        writeFileAtomically(LATER_DIRECTORY, [](std::ostream& os)
+        {
+            os << "new";
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+    CHECK(!exists(LATER_DIRECTORY + ".tmp"));
+    std::filesystem::remove(LATER_DIRECTORY);
+
+    // the stream failing, which cleans up after itself
+    thrown = false;
+    try
+    {
+        writeFileAtomically(SAVED_FILE, [](std::ostream& os)
+        {
+            os << "new";
+            os.setstate(std::ios::badbit);
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+    CHECK(readFile(SAVED_FILE) == "old");
+    CHECK(!exists(SAVED_FILE + ".tmp"));
+
+    writeFileAtomically(SAVED_FILE, [](std::ostream& os) { os << "new"; });
+    CHECK(readFile(SAVED_FILE) == "new");
+}
+
+// a process killed while it saves leaves the last whole file
+void testCrash()
+{
+#ifndef _WIN32
+    int status = 0;
+    pid_t child;
+
+    writeFileAtomically(SAVED_FILE, [](std::ostream& os) { os << "old"; });
+
+    child = fork();
+    if (child == 0)
+    {
+        writeFileAtomically(SAVED_FILE, [](std::ostream& os)
+        {
+            os << "half of the new" << std::flush;
+            // no destructors, no rename, like the power going out
+            _exit(3);
+        });
+        _exit(0);
+    }
+
+    CHECK(child > 0 && waitpid(child, &status, 0) == child);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 3);
+    CHECK(readFile(SAVED_FILE) == "old");
+
+    // the next save goes over what the crash left behind
+    writeFileAtomically(SAVED_FILE, [](std::ostream& os) { os << "new"; });
+    CHECK(readFile(SAVED_FILE) == "new");
+    CHECK(!exists(SAVED_FILE + ".tmp"));
+#endif
+}
+
+// a burst of saves is folded into a few, and what's on disk after a
+// flush is the newest
+void testGroupCommit()
+{
+    std::atomic<int> version(0);
+    std::atomic<int> secondAt(-1);
+
+    {
+        GroupCommit saver(SAVED_FILE, [&version](std::ostream& os)
+        {
+            os << version.load();
+        }, std::chrono::milliseconds(50));
+
+        saver.addFile(SECOND_FILE, [&](std::ostream& os)
+        {
+            // the second file is always written after the first
+            secondAt = std::stoi(readFile(SAVED_FILE));
+            os << secondAt.load();
+        });
+
+        for (int i = 1; i <= 100; i++)
+        {
+            version = i;
+            saver.request();
+        }
+
+        saver.flush();
+
+        CHECK(readFile(SAVED_FILE) == "100");
+        CHECK(readFile(SECOND_FILE) == "100");
+        CHECK(saver.saves() >= 1 && saver.saves() < 100);
+
+        // with nothing asked for, a flush doesn't wait
+        saver.flush();
+
+        // what's still asked for is saved on the way out
+        version = 101;
+        saver.request();
+    }
+
+    CHECK(readFile(SAVED_FILE) == "101");
+    CHECK(secondAt == 101);
+}
+
+
+// a save that fails isn't counted as on the disk, flush says so, and
+// it's tried again until it makes it
+void testFailedSave()
+{
+    string path = LATER_DIRECTORY + "/saved.txt";
+    std::atomic<int> version(1);
+
+    std::filesystem::remove_all(LATER_DIRECTORY);
+
+    {
+        GroupCommit saver(path, [&version](std::ostream& os)
+        {
+            os << version.load();
+        }, std::chrono::milliseconds(10));
+
+        saver.request();
+        CHECK(!saver.flush());
+        CHECK(saver.saves() == 0);
+
+        // the directory turning up lets a later try through, one already
+        // on its way can still fail
+        std::filesystem::create_directory(LATER_DIRECTORY);
+        version = 2;
+
+        bool saved = false;
+
+        for (int i = 0; i < 10 && !saved; i++)
+            saved = saver.flush();
+
+        CHECK(saved);
+        CHECK(saver.saves() == 1);
+        CHECK(readFile(path) == "2");
+
+        // and with it gone again, the last try on the way out gives up
+        std::filesystem::remove_all(LATER_DIRECTORY);
+        saver.request();
+    }
+
+    CHECK(!exists(path));
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// read a file
+string readFile(const string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream text;
+
+    text << in.rdbuf();
+
+    return text.str();
+}
+
+// is a file there
+bool exists(const string& path)
+{
+    return std::ifstream(path).is_open();
+}
+
+int main()
+{
+    testAtomicWrite();
+    testCrash();
+    testGroupCommit();
+    testFailedSave();
+
+    std::remove(SAVED_FILE.c_str());
+    std::remove(SECOND_FILE.c_str());
+    std::remove((SAVED_FILE + ".tmp").c_str());
+
+    return testResult("durable_file");
+}
@@ -0,0 +1,186 @@
+// includes
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../io/event_json.hpp"
+#include "../io/list_file.hpp"
+#include "../view/jsonl.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes events with every field json keeps
+// requires: nothing
+// returns: the events
+vector<Event> makeEvents();
+
+// purpose: determines if two events are the same, id and schedule too
+// requires: two events
+// returns: a boolean
+bool sameEvent(const Event&, const Event&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// an event comes back the same out of text and every binary format
+void testRoundTrip()
+{
+    for (auto &i : makeEvents())
+    {
+        json j = i;
+
+        CHECK(sameEvent(json::parse(j.dump()).get<Event>(), i));
+        CHECK(sameEvent(json::from_cbor(json::to_cbor(j)).get<Event>(), i));
+        CHECK(sameEvent(json::from_msgpack(json::to_msgpack(j))
+            .get<Event>(), i));
+        CHECK(sameEvent(json::from_ubjson(json::to_ubjson(j))
+            .get<Event>(), i));
+        CHECK(sameEvent(json::from_bson(json::to_bson(j)).get<Event>(), i));
+    }
+}
+
+// the json has the shape of an entry of the list file, and of a line of
+// jsonl without its priority
+void testShape()
+{
+    vector<Event> events = makeEvents();
+    std::ostringstream file;
+
+    writeListJSON(file, events, true);
+
+    json list = json::parse(file.str())["to do list"];
+
+    CHECK(list.size() == events.size());
+
+    for (size_t i = 0; i < events.size() && i < list.size(); i++)
+    {
+        std::ostringstream line;
+
+        writeJSONLine(line, events[i]);
+
+        json j = json::parse(line.str());
+
+        j.erase("priority");
+        CHECK(json(events[i]) == list[i]);
+        CHECK(json(events[i]) == j);
+    }
+}
+
+// a time point takes its month by name or number, and fills in the rest
+void testTimePoint()
+{
+    TimePoint point(2024, Months::February, 29, 23, 59);
+    json j = point;
+    bool thrown = false;
+
+    CHECK(j.get<TimePoint>() == point);
+    CHECK(j["month"] == "February");
+
+    j["month"] = 2;
+    CHECK(j.get<TimePoint>() == point);
+
+    CHECK(json::parse(R"({ "year": 2023, "extra": [1, 2] })")
+        .get<TimePoint>() == TimePoint(2023, Months::January, 1, 12, 0));
+    CHECK(json::parse(R"({ "year": 2023, "day": "3" })")
+        .get<TimePoint>() == TimePoint(2023, Months::January, 1, 12, 0));
+
+    for (const char* month : { "\"Smarch\"", "0", "13" })
+    {
+        try
+        {
+            json::parse(string("{ \"month\": ") + month + " }")
+                .get<TimePoint>();
+        }
+        catch (const std::invalid_argument&)
+        {
+            thrown = true;
+        }
+
+        CHECK(thrown);
+        thrown = false;
+    }
+}
+
+// an event with fields missing or of the wrong type gets the blanks
+void testBlanks()
+{
+    Event blank = json::parse(R"({ "title": 7, "importance": "high",
+        "repeat": "hourly", "bias": 0.5, "unknown": null })").get<Event>();
+
+    CHECK(blank.get_name().empty());
+    CHECK(blank.get_importance() == 1);
+    CHECK(blank.get_bias() == 0.5);
+    CHECK(!blank.is_recurring());
+    CHECK(blank.get_zone() == 0);
+    CHECK(blank.get_due_date() == TimePoint(0, Months::January, 1, 12, 0));
+
+    // and so does a number its field can't hold
+    for (const char* number : { "2.5", "1e300", "-1e300" })
+    {
+        string text = string("{ \"importance\": ") + number + ", \"id\": "
+            + number + ", \"due_date\": { \"year\": 2023, \"day\": "
+            + number + ", \"hour\": " + number + " } }";
+        Event odd = json::parse(text).get<Event>();
+
+        CHECK(odd.get_importance() == 1);
+        CHECK(odd.get_id() == 0);
+        CHECK(odd.get_due_date()
+            == TimePoint(2023, Months::January, 1, 12, 0));
+    }
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// make events
+vector<Event> makeEvents()
+{
+    vector<Event> events;
+
+    events.emplace_back("plain", TimePoint(2023, Months::March, 14, 15, 9));
+    events.emplace_back("caf\xc3\xa9 \"quoted\"\n\ttabbed",
+        TimePoint(1999, Months::December, 31, 23, 59), 5, -0.1,
+        "a \\ description \x01 with controls");
+    events.emplace_back("zoned", TimePoint(2024, Months::November, 3, 1, 30),
+        2, 1e-9, "");
+    events.back().set_zone(ZONES.find("America/New_York"));
+    events.back().set_repeat(parseRecurrence(
+        "FREQ=MONTHLY;BYDAY=1SU;UNTIL=20291231"));
+
+    for (size_t i = 0; i < events.size(); i++)
+        events[i].set_id(static_cast<unsigned>(i * 1000 + 1));
+
+    return events;
+}
+
+// compare events
+bool sameEvent(const Event& a, const Event& b)
+{
+    return a == b && a.get_id() == b.get_id()
+        && a.get_schedule() == b.get_schedule();
+}
+
+int main()
+{
+    testRoundTrip();
+    testShape();
+    testTimePoint();
+    testBlanks();
+
+    return testResult("event_json");
+}
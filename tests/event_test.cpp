@@ -0,0 +1,90 @@
+// includes
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include "../event/event.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::vector;
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// the priority keeps rising the longer an event is overdue, and once it
+// can't it stays finite and the due date breaks the tie
+void testOverduePriority()
+{
+    vector<Event> events;
+
+    NOW = TimePoint::fromMinutes(28000000);
+
+    for (int hours : { 100000, 10, 0, -10, -37, -50, -79, -100, -1000 })
+        events.emplace_back("overdue", TimePoint::fromMinutes(
+            28000000 + hours * 60));
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        CHECK(std::isfinite(events[i].get_priority()));
+
+        if (i > 0)
+            CHECK(events[i - 1] < events[i]);
+    }
+
+    for (size_t i = 1; i < 7; i++)
+        CHECK(events[i - 1].get_priority() < events[i].get_priority());
+}
+
+// more important events come first when they're due at the same time
+void testImportance()
+{
+    NOW = TimePoint::fromMinutes(28000000);
+
+    TimePoint due = TimePoint::fromMinutes(28000000 + 600);
+    Event low("low", due, 1);
+    Event high("high", due, 5);
+
+    CHECK(low < high);
+    CHECK(high > low);
+    CHECK(high.get_priority() > low.get_priority());
+}
+
+// the strings come back as views into the tables, so reading and
+// comparing events doesn't copy them
+void testStringViews()
+{
+    static_assert(std::is_same<decltype(Event().get_name()),
+        string_view>::value, "the name is a view");
+    static_assert(std::is_same<decltype(Event().get_description()),
+        string_view>::value, "the description is a view");
+
+    Event a("a title", TimePoint(2023, Months::May, 1, 9, 0), 2, 0.5,
+        "a description");
+    Event b("a title", TimePoint(2023, Months::May, 2, 9, 0));
+    string_view name = a.get_name();
+
+    CHECK(a.get_title() == b.get_title());
+    CHECK(name.data() == b.get_name().data());
+    CHECK(a.get_description().data() == a.get_description().data());
+    CHECK(a.get_description() == "a description");
+    CHECK(b.get_description().empty());
+    CHECK(b < a && a != b);
+
+    b.set_name(string_view("another"));
+    CHECK(b.get_name() == "another");
+    CHECK(a.get_name().data() == name.data());
+}
+
+int main()
+{
+    testOverduePriority();
+    testImportance();
+    testStringViews();
+
+    return testResult("event");
+}
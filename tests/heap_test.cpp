@@ -0,0 +1,140 @@
+// includes
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "../heap/heap.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes numbers that look shuffled, the same ones every run
+// requires: how many, and where to start
+// returns: the numbers
+vector<int> scrambled(size_t, std::uint32_t seed);
+
+// purpose: empties a heap from the top, the way the shell finishes events
+// requires: a heap
+// returns: what came off, biggest first if it was a heap
+vector<int> drain(vector<int>);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// heapify makes the same layout std::make_heap accepts, and each element
+// comes off in order
+void testHeapify()
+{
+    for (size_t size : { 0, 1, 2, 3, 100, 1001 })
+    {
+        vector<int> heap = scrambled(size, 7);
+        vector<int> sorted = heap;
+
+        heapify(heap);
+        std::sort(sorted.rbegin(), sorted.rend());
+
+        CHECK(std::is_heap(heap.begin(), heap.end()));
+        CHECK(drain(heap) == sorted);
+    }
+}
+
+// a batch goes onto a heap whether it's small next to the heap, and is
+// sifted up, or big, and the whole thing is heapified
+void testBulkIngest()
+{
+    for (size_t added : { 0, 1, 5, 500, 5000 })
+    {
+        vector<int> heap = scrambled(1000, 11);
+        vector<int> batch = scrambled(added, 13);
+        vector<int> all = heap;
+
+        all.insert(all.end(), batch.begin(), batch.end());
+        std::sort(all.rbegin(), all.rend());
+
+        heapify(heap);
+        bulkIngest(heap, std::move(batch));
+
+        CHECK(batch.empty());
+        CHECK(heap.size() == all.size());
+        CHECK(std::is_heap(heap.begin(), heap.end()));
+        CHECK(drain(heap) == all);
+    }
+
+    // onto nothing at all
+    vector<int> heap;
+
+    bulkIngest(heap, scrambled(64, 17));
+    CHECK(heap.size() == 64);
+    CHECK(std::is_heap(heap.begin(), heap.end()));
+}
+
+// an element that changed goes back where it belongs, up or down
+void testFixHeap()
+{
+    vector<int> heap = scrambled(300, 19);
+
+    heapify(heap);
+
+    for (size_t i = 0; i < heap.size(); i += 37)
+    {
+        heap[i] = i % 2 == 0 ? heap[i] + 100000 : heap[i] - 100000;
+        fixHeap(heap, i);
+        CHECK(std::is_heap(heap.begin(), heap.end()));
+    }
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// make numbers
+vector<int> scrambled(size_t count, std::uint32_t seed)
+{
+    vector<int> numbers;
+
+    // a small linear congruential generator, with repeats kept in
+    for (size_t i = 0; i < count; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        numbers.push_back(static_cast<int>(seed >> 16) % 5000);
+    }
+
+    return numbers;
+}
+
+// empty a heap
+vector<int> drain(vector<int> heap)
+{
+    vector<int> out;
+
+    while (!heap.empty())
+    {
+        out.push_back(heap.front());
+        heap.front() = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+            siftDown(heap, 0);
+    }
+
+    return out;
+}
+
+int main()
+{
+    testHeapify();
+    testBulkIngest();
+    testFixHeap();
+
+    return testResult("heap");
+}
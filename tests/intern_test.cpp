@@ -0,0 +1,97 @@
+// includes
+
+#include <string>
+#include "../event/event.hpp"
+#include "../memory/arena.hpp"
+#include "../memory/intern.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// the same string always gets the same symbol, kept once, and a
+// different one a different symbol
+void testIntern()
+{
+    Arena arena;
+    SymbolTable table(arena);
+    string rent = "pay rent";
+    Symbol first = table.intern(rent);
+
+    CHECK(table.intern("") == 0);
+    CHECK(table.size() == 2);
+
+    // the table keeps its own copy, not the caller's string
+    rent[0] = 'P';
+    CHECK(table.name(first) == "pay rent");
+    CHECK(table.intern("pay rent") == first);
+    CHECK(table.intern(rent) != first);
+    CHECK(table.size() == 3);
+
+    size_t used = arena.bytesUsed();
+
+    for (int i = 0; i < 1000; i++)
+        CHECK(table.intern("pay rent") == first);
+    CHECK(arena.bytesUsed() == used);
+}
+
+// looking a string up never adds it
+void testFind()
+{
+    Arena arena;
+    SymbolTable table(arena);
+    Symbol dentist = table.intern("dentist");
+
+    CHECK(table.find("dentist") == dentist);
+    CHECK(table.find("") == 0);
+    CHECK(table.find("dentists") == SymbolTable::NONE);
+    CHECK(table.size() == 2);
+}
+
+// a reset forgets everything but the empty string, along with the arena
+void testReset()
+{
+    Arena arena;
+    SymbolTable table(arena);
+
+    for (int i = 0; i < 100; i++)
+        table.intern("event " + std::to_string(i));
+
+    arena.reset();
+    table.reset();
+
+    CHECK(table.size() == 1);
+    CHECK(table.find("event 7") == SymbolTable::NONE);
+    CHECK(table.intern("event 7") == 1);
+    CHECK(table.name(1) == "event 7");
+}
+
+// events with the same title share its symbol, and compare by it
+void testEventTitles()
+{
+    Event a("dentist", TimePoint(2023, Months::May, 1, 9, 30));
+    Event b(string("dent") + "ist", TimePoint(2023, Months::May, 2, 9, 30));
+    Event c("dentists", TimePoint(2023, Months::May, 1, 9, 30));
+
+    CHECK(a.get_title() == b.get_title());
+    CHECK(a.get_title() != c.get_title());
+    CHECK(TITLES.name(a.get_title()) == "dentist");
+    CHECK(a.get_name() == "dentist");
+}
+
+int main()
+{
+    testIntern();
+    testFind();
+    testReset();
+    testEventTitles();
+
+    return testResult("intern");
+}
@@ -0,0 +1,217 @@
+// includes
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../io/list_decoder.hpp"
+#include "../io/list_file.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes a list of events with every field the list file has
+// requires: how many
+// returns: the events
+vector<Event> makeEvents(size_t);
+
+// purpose: writes events as a list file
+// requires: the events and whether to minify
+// returns: the text
+string listText(const vector<Event>&, bool minified);
+
+// purpose: checks two lists of events are the same, in the same order
+// requires: the lists
+// returns: true if they are
+bool sameEvents(const vector<Event>&, const vector<Event>&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// the decoder reads what the general parser reads
+void testMatchesGeneral()
+{
+    for (bool minified : { false, true })
+    {
+        string text = listText(makeEvents(500), minified);
+        vector<Event> general;
+        vector<Event> decoded;
+        ParsedEvents parsed;
+
+        CHECK(decodeListFile(text, parsed));
+        CHECK(parsed.entries.size() == 500);
+        CHECK(readListEvents(text, general));
+        CHECK(readListEventsDecoded(text, decoded));
+        CHECK(sameEvents(general, decoded));
+    }
+}
+
+// a month the decoder can't take is turned down, and the fallback throws
+// what the general parser does
+void testBadMonth()
+{
+    string text = listText(makeEvents(20), true);
+    bool thrown = false;
+    vector<Event> events;
+    ParsedEvents parsed;
+
+    text.replace(text.rfind("\"March\""), 7, "\"Smarch\"");
+    CHECK(!decodeListFile(text, parsed));
+
+    try
+    {
+        readListEventsDecoded(text, events);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+}
+
+// text that isn't a list file is turned down, whichever reader reads it
+void testMalformed()
+{
+    string text = listText(makeEvents(20), true);
+    vector<string> broken = { "", "[", "{", text.substr(0, text.size() / 2),
+        text.substr(0, text.rfind('}')), text + "}" };
+
+    for (auto &i : broken)
+    {
+        vector<Event> general;
+        vector<Event> decoded;
+        ParsedEvents parsed;
+
+        CHECK(!decodeListFile(i, parsed));
+        CHECK(!readListEvents(i, general));
+        CHECK(!readListEventsDecoded(i, decoded));
+        CHECK(decoded.empty());
+    }
+}
+
+// an event due too far off to store is left out, and the rest still load
+void testFarDueDate()
+{
+    string text = listText(makeEvents(20), true);
+    size_t year = text.find("\"year\":") + 7;
+    vector<Event> general;
+    vector<Event> decoded;
+
+    text.replace(year, text.find_first_not_of("0123456789", year) - year,
+        "99999");
+
+    CHECK(readListEvents(text, general));
+    CHECK(readListEventsDecoded(text, decoded));
+    CHECK(general.size() == 19);
+    CHECK(sameEvents(general, decoded));
+    CHECK(general[0].get_id() == 2);
+}
+
+// a number a field can't hold is left out like a value of the wrong type,
+// whichever reader reads it
+void testBadNumbers()
+{
+    vector<string> importances = { "-1", "2.5", "70000", "1e300" };
+    vector<string> ids = { "-3", "0.5", "4294967296", "1e300" };
+    vector<string> days = { "0.5", "2147483648", "-1e300", "1e300" };
+
+    for (size_t i = 0; i < importances.size(); i++)
+    {
+        string text = "{\"to do list\":[{\"title\":\"odd\",\"importance\":"
+            + importances[i] + ",\"id\":" + ids[i] + ",\"due_date\":{"
+            "\"year\":2023,\"month\":\"May\",\"day\":" + days[i]
+            + ",\"hour\":9,\"minute\":30}}]}";
+        vector<Event> general;
+        vector<Event> decoded;
+
+        CHECK(readListEvents(text, general));
+        CHECK(readListEventsDecoded(text, decoded));
+        CHECK(general.size() == 1);
+        CHECK(sameEvents(general, decoded));
+
+        if (general.size() != 1)
+            continue;
+
+        CHECK(general[0].get_importance() == 1);
+        CHECK(general[0].get_id() == 0);
+        CHECK(general[0].get_due_date()
+            == TimePoint(2023, Months::May, 1, 9, 30));
+    }
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// make events
+vector<Event> makeEvents(size_t count)
+{
+    vector<Event> events;
+    const char* titles[] = { "pay rent", "dentist", "essay \"draft\"",
+        "caf\xc3\xa9 shift", "call\nhome\t\\" };
+    ZoneId york = ZONES.find("America/New_York");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        events.emplace_back(titles[i % 5], TimePoint::fromMinutes(
+            28000000 + static_cast<long long>(i) * 1009), 1 + i % 5,
+            (i % 7) * 0.25 - 0.5, "notes " + std::to_string(i));
+        events.back().set_id(static_cast<unsigned>(i + 1));
+
+        if (i % 3 == 0)
+            events.back().set_zone(york);
+        if (i % 4 == 0)
+            events.back().set_repeat(parseRecurrence(i % 8
+                ? "FREQ=WEEKLY;INTERVAL=2" : "FREQ=MONTHLY;BYMONTHDAY=31"));
+    }
+
+    return events;
+}
+
+// write a list file
+string listText(const vector<Event>& events, bool minified)
+{
+    std::ostringstream os;
+
+    writeListJSON(os, events, minified);
+
+    return os.str();
+}
+
+// compare lists
+bool sameEvents(const vector<Event>& a, const vector<Event>& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i] != b[i] || a[i].get_id() != b[i].get_id()
+            || a[i].get_schedule() != b[i].get_schedule())
+            return false;
+
+    return true;
+}
+
+int main()
+{
+    testMatchesGeneral();
+    testBadMonth();
+    testMalformed();
+    testFarDueDate();
+    testBadNumbers();
+
+    return testResult("list_decoder");
+}
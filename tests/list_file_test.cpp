@@ -0,0 +1,198 @@
+// includes
+
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "../io/list_file.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /******************\
+    *  CountingBuffer  *
+    \******************/
+
+// a stream buffer that keeps what's written to it, and counts how many
+// times it was written to
+class CountingBuffer : public std::streambuf
+{
+public:
+
+    string text;
+    int writes = 0;
+
+protected:
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override
+    {
+        text.append(data, static_cast<size_t>(size));
+        writes++;
+        return size;
+    }
+
+    int_type overflow(int_type c) override
+    {
+        if (c != traits_type::eof())
+        {
+            text.push_back(traits_type::to_char_type(c));
+            writes++;
+        }
+        return c;
+    }
+};
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes events with every field the list file has
+// requires: how many
+// returns: the events
+vector<Event> makeEvents(size_t);
+
+// purpose: writes events as a list file
+// requires: the events and whether to minify
+// returns: the text
+string listText(const vector<Event>&, bool minified);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// every entry has the keys the file has always had, in the same order,
+// and the optional ones only when they're set
+void testSchema()
+{
+    vector<Event> events = makeEvents(4);
+    // kept in the order the keys were written
+    nlohmann::ordered_json file = nlohmann::ordered_json::parse(
+        listText(events, false));
+    vector<string> keys = { "bias", "description", "due_date", "id",
+        "importance", "repeat", "time_zone", "title" };
+
+    CHECK(file.size() == 1);
+    CHECK(file["to do list"].size() == events.size());
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const nlohmann::ordered_json& entry = file["to do list"][i];
+        vector<string> found;
+        vector<string> wanted;
+
+        for (auto &j : entry.items())
+            found.push_back(j.key());
+        for (auto &j : keys)
+            if ((j != "repeat" || events[i].is_recurring())
+                && (j != "time_zone" || events[i].get_zone() != 0))
+                wanted.push_back(j);
+
+        CHECK(found == wanted);
+        CHECK(entry["title"] == events[i].get_name());
+        CHECK(entry["id"] == events[i].get_id());
+        CHECK(entry["due_date"]["month"] == "March");
+    }
+}
+
+// what's saved from the events reads back as the same events, ids and
+// schedules too
+void testRoundTrip()
+{
+    vector<Event> events = makeEvents(50);
+    vector<Event> read;
+
+    CHECK(readListEvents(listText(events, false), read));
+    CHECK(read.size() == events.size());
+
+    for (size_t i = 0; i < read.size() && i < events.size(); i++)
+        CHECK(read[i] == events[i] && read[i].get_id() == events[i].get_id()
+            && read[i].get_schedule() == events[i].get_schedule());
+
+    // an empty list is still a list
+    read.clear();
+    CHECK(readListEvents(listText({ }, false), read));
+    CHECK(read.empty());
+}
+
+// the file comes out indented by 4 or minified, the same as the json
+// library writes it, and a long list is handed over a block at a time
+// instead of built up whole
+void testFormats()
+{
+    vector<Event> events = makeEvents(2000);
+
+    for (bool minified : { false, true })
+    {
+        CountingBuffer buffer;
+        std::ostream os(&buffer);
+        json file;
+
+        writeListJSON(os, events, minified);
+        file = json::parse(buffer.text);
+
+        CHECK(buffer.text == (minified ? file.dump() : file.dump(4)) + "\n");
+        CHECK(buffer.writes > 1);
+        CHECK(buffer.writes
+            <= static_cast<int>(buffer.text.size() / LIST_FLUSH_SIZE) + 1);
+    }
+
+    // a short list goes over in one write
+    CountingBuffer buffer;
+    std::ostream os(&buffer);
+
+    writeListJSON(os, makeEvents(3), true);
+    CHECK(buffer.writes == 1);
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// make events
+vector<Event> makeEvents(size_t count)
+{
+    vector<Event> events;
+    ZoneId paris = ZONES.find("Europe/Paris");
+
+    for (size_t i = 0; i < count; i++)
+    {
+        events.emplace_back("event \"" + std::to_string(i) + "\"",
+            TimePoint(2024, Months::March, 1 + i % 28, i % 24, i % 60),
+            1 + i % 3, (i % 5) * 0.5 - 1.0, i % 2 ? "" : "notes\n\ttabbed");
+        events.back().set_id(static_cast<unsigned>(i + 1));
+
+        if (i % 3 == 1)
+            events.back().set_zone(paris);
+        if (i % 4 == 2)
+            events.back().set_repeat(parseRecurrence("FREQ=WEEKLY"));
+    }
+
+    return events;
+}
+
+// write a list file
+string listText(const vector<Event>& events, bool minified)
+{
+    std::ostringstream os;
+
+    writeListJSON(os, events, minified);
+
+    return os.str();
+}
+
+int main()
+{
+    testSchema();
+    testRoundTrip();
+    testFormats();
+
+    return testResult("list_file");
+}
@@ -0,0 +1,207 @@
+// includes
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../io/list_store.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the store the test saves, next to it
+const string STORE_FILE = "list_store_test.bin";
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes a heap of events with every field the store keeps
+// requires: how many
+// returns: the events, in heap order
+vector<Event> makeHeap(size_t);
+
+// purpose: writes a store
+// requires: the path and the events
+// returns: nothing
+void saveStore(const string&, const vector<Event>&);
+
+// purpose: determines if two events are the same, id and schedule too
+// requires: two events
+// returns: a boolean
+bool sameEvent(const Event&, const Event&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// the store gives back the events it was saved with, in heap order and
+// in priority order
+void testRoundTrip()
+{
+    vector<Event> heap = makeHeap(700);
+    vector<Event> ranked = heap;
+    ListStore store;
+    bool same = true;
+
+    saveStore(STORE_FILE, heap);
+    std::sort(ranked.begin(), ranked.end(), std::greater<Event>());
+
+    CHECK(store.open(STORE_FILE));
+    CHECK(store.size() == heap.size());
+
+    for (size_t i = 0; i < heap.size(); i++)
+    {
+        same = same && sameEvent(store.event(store.record(i)), heap[i]);
+        same = same && sameEvent(store.event(store.ranked(i)), ranked[i]);
+    }
+
+    CHECK(same);
+    CHECK(store.rankAfter(ranked[9].get_id()) == 10);
+    CHECK(store.rankAfter(100000) == ListStore::npos);
+    CHECK(store.findTitle("title 3") == static_cast<size_t>(std::find_if(
+        heap.begin(), heap.end(), [](const Event& e)
+        {
+            return e.get_name() == "title 3";
+        }) - heap.begin()));
+    CHECK(store.findTitle("no such title") == ListStore::npos);
+
+    bool thrown = false;
+
+    try
+    {
+        store.record(heap.size());
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+
+    store.close();
+    CHECK(!store.isOpen() && store.size() == 0);
+}
+
+// an empty list makes a store too
+void testEmpty()
+{
+    ListStore store;
+
+    saveStore(STORE_FILE, {});
+
+    CHECK(store.open(STORE_FILE));
+    CHECK(store.size() == 0);
+    CHECK(store.rankAfter(1) == ListStore::npos);
+}
+
+// a store that was cut short, or isn't one, isn't opened
+void testDamaged()
+{
+    vector<Event> heap = makeHeap(20);
+    std::ostringstream whole;
+    ListStore store;
+
+    writeListStore(whole, heap);
+
+    string text = whole.str();
+    string broken[] = { "", text.substr(0, 10), text.substr(0, 100),
+        text.substr(0, text.size() - 1), text + "x",
+        "XDL1" + text.substr(4) };
+
+    for (auto &i : broken)
+    {
+        std::ofstream(STORE_FILE, std::ios::binary) << i;
+        CHECK(!store.open(STORE_FILE) && !store.isOpen());
+    }
+
+    CHECK(!store.open("no_such_store.bin"));
+}
+
+// the store lives next to its list and is only used while it's newer
+void testPaths()
+{
+    std::ofstream("list_store_test.json") << "{}";
+    saveStore("list_store_test.bin", {});
+
+    CHECK(storePathFor("list_store_test.json") == "list_store_test.bin");
+    CHECK(storeIsFresh("list_store_test.json", "list_store_test.bin"));
+    CHECK(!storeIsFresh("list_store_test.json", "no_such_store.bin"));
+
+    std::remove("list_store_test.json");
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// make a heap
+vector<Event> makeHeap(size_t count)
+{
+    vector<Event> events;
+    ZoneId zones[] = { 0, ZONES.find("America/New_York"),
+        ZONES.find("Asia/Tokyo") };
+
+    NOW = TimePoint::fromMinutes(28000000);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        events.emplace_back("title " + std::to_string(i % 50),
+            TimePoint::fromMinutes(28000000 + (static_cast<long long>(i)
+            * 7919) % 20000 - 5000), 1 + i % 4, (i % 5) * 0.3,
+            i % 3 ? "" : "description " + std::to_string(i));
+        events.back().set_id(static_cast<unsigned>(i + 1));
+        events.back().set_zone(zones[i % 3]);
+
+        if (i % 4 == 0)
+            events.back().set_repeat(parseRecurrence("FREQ=WEEKLY"));
+    }
+
+    std::make_heap(events.begin(), events.end());
+
+    return events;
+}
+
+// save a store
+void saveStore(const string& path, const vector<Event>& events)
+{
+    std::ofstream file(path, std::ios::binary);
+
+    writeListStore(file, events);
+}
+
+// compare events
+bool sameEvent(const Event& a, const Event& b)
+{
+    return a == b && a.get_id() == b.get_id()
+        && a.get_schedule() == b.get_schedule()
+        && a.get_priority() == b.get_priority();
+}
+
+int main()
+{
+    testRoundTrip();
+    testEmpty();
+    testDamaged();
+    testPaths();
+
+    std::remove(STORE_FILE.c_str());
+
+    return testResult("list_store");
+}
@@ -0,0 +1,119 @@
+// includes
+
+#include <stdexcept>
+#include <string>
+#include "../event/month_codec.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: determines if text is read as a month
+// requires: the text
+// returns: the month, or 0 if stom throws
+int readMonth(string_view);
+
+// the codec works when the code is compiled
+static_assert(stom("march") == Months::March, "read at compile time");
+static_assert(mtos(Months::October) == "October", "written at compile time");
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// every month is read by its name in any case, its first three letters,
+// and its number, and written back by its name
+void testMonths()
+{
+    for (int i = Months::January; i <= Months::December; i++)
+    {
+        string name(MONTH_NAMES[i]);
+        string lower = name;
+        string upper = name;
+        string number = std::to_string(i);
+
+        for (auto &c : lower)
+            c = static_cast<char>(c | 0x20);
+        for (auto &c : upper)
+            c = static_cast<char>(c & ~0x20);
+
+        CHECK(readMonth(name) == i);
+        CHECK(readMonth(lower) == i);
+        CHECK(readMonth(upper) == i);
+        CHECK(readMonth(name.substr(0, 3)) == i);
+        CHECK(readMonth(upper.substr(0, 3)) == i);
+        CHECK(readMonth(number) == i);
+        CHECK(readMonth((i < 10 ? "0" : "") + number) == i);
+        CHECK(mtos(static_cast<Months>(i)) == name);
+    }
+
+    CHECK(mtos(static_cast<Months>(0)).empty());
+    CHECK(mtos(static_cast<Months>(13)).empty());
+}
+
+// near misses aren't months
+void testNotMonths()
+{
+    for (string_view i : { "", "M", "Ma", "Mar.", "Marc", "Marchh", "March ",
+        " March", "Smarch", "Jux", "Mayo", "Sept", "0", "00", "13", "1a",
+        "a1", "001", "-1", "+1" })
+        CHECK(readMonth(i) == 0);
+}
+
+// of every three printable characters, only the months' first three
+// letters are read, whatever the hash makes of the rest
+void testEveryThreeLetters()
+{
+    int found = 0;
+    char text[3];
+
+    for (int a = ' '; a <= '~'; a++)
+        for (int b = ' '; b <= '~'; b++)
+            for (int c = ' '; c <= '~'; c++)
+            {
+                text[0] = static_cast<char>(a);
+                text[1] = static_cast<char>(b);
+                text[2] = static_cast<char>(c);
+
+                if (readMonth(string_view(text, 3)) != 0)
+                    found++;
+            }
+
+    // each month in 8 mixes of case
+    CHECK(found == 12 * 8);
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// read a month
+int readMonth(string_view text)
+{
+    try
+    {
+        return stom(text);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return 0;
+    }
+}
+
+int main()
+{
+    testMonths();
+    testNotMonths();
+    testEveryThreeLetters();
+
+    return testResult("month_codec");
+}
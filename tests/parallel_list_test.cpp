@@ -0,0 +1,179 @@
+// includes
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../io/list_file.hpp"
+#include "../io/parallel_list.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: makes a list of events with some variety in them
+// requires: how many, and how long the last one's description is
+// returns: the events
+vector<Event> makeEvents(size_t, size_t lastDescription);
+
+// purpose: writes events as a list file
+// requires: the events and whether to minify
+// returns: the text
+string listText(const vector<Event>&, bool minified);
+
+// purpose: checks two lists of events are the same, in the same order
+// requires: the lists
+// returns: true if they are
+bool sameEvents(const vector<Event>&, const vector<Event>&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// every thread count reads what the serial reader reads
+void testMatchesSerial()
+{
+    for (bool minified : { false, true })
+    {
+        string text = listText(makeEvents(20000, 10), minified);
+        vector<Event> serial;
+
+        CHECK(text.size() > PARALLEL_LOAD_MIN_BYTES);
+        CHECK(readListEvents(text, serial));
+
+        for (unsigned threads : { 1u, 2u, 3u, 4u, 7u, 16u })
+        {
+            vector<Event> parallel;
+
+            CHECK(readListEventsParallel(text, parallel, threads));
+            CHECK(sameEvents(serial, parallel));
+        }
+    }
+}
+
+// a last entry bigger than a thread's share doesn't make an empty run
+void testOversizedLastEntry()
+{
+    for (unsigned threads : { 2u, 3u, 4u })
+    {
+        string text = listText(makeEvents(50, 1536 * 1024), true);
+        vector<Event> serial;
+        vector<Event> parallel;
+
+        CHECK(readListEvents(text, serial));
+        CHECK(readListEventsParallel(text, parallel, threads));
+        CHECK(sameEvents(serial, parallel));
+    }
+}
+
+// a value the reader can't take is thrown, not left to kill a thread
+void testBadMonthThrows()
+{
+    string text = listText(makeEvents(20000, 10), true);
+    size_t month = text.rfind("\"March\"");
+    bool thrown = false;
+    vector<Event> events;
+
+    CHECK(month != string::npos);
+    text.replace(month, 7, "\"Smarch\"");
+
+    try
+    {
+        readListEventsParallel(text, events, 4);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    CHECK(thrown);
+}
+
+// text that isn't a list file is turned down without appending anything
+void testMalformed()
+{
+    string text = listText(makeEvents(20000, 10), true);
+    size_t middle = text.find("},{", text.size() / 2);
+    vector<string> broken = { text.substr(0, text.size() / 2),
+        text.substr(0, text.size() - 2),
+        text.substr(0, middle) + "}}" + text.substr(middle),
+        text + "]" };
+
+    for (auto &i : broken)
+    {
+        vector<Event> serial;
+        vector<Event> parallel;
+
+        CHECK(!readListEvents(i, serial));
+        CHECK(!readListEventsParallel(i, parallel, 4));
+        CHECK(parallel.empty());
+    }
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// make events
+vector<Event> makeEvents(size_t count, size_t lastDescription)
+{
+    vector<Event> events;
+    const char* titles[] = { "pay rent", "dentist", "essay \"draft\"",
+        "caf\xc3\xa9 shift", "call\nhome" };
+
+    for (size_t i = 0; i < count; i++)
+    {
+        string description = i + 1 == count
+            ? string(lastDescription, 'x') : "notes " + std::to_string(i);
+
+        events.emplace_back(titles[i % 5], TimePoint::fromMinutes(
+            28000000 + static_cast<long long>(i) * 97), 1 + i % 5,
+            (i % 7) * 0.5, description);
+        events.back().set_id(static_cast<unsigned>(i + 1));
+    }
+
+    return events;
+}
+
+// write a list file
+string listText(const vector<Event>& events, bool minified)
+{
+    std::ostringstream os;
+
+    writeListJSON(os, events, minified);
+
+    return os.str();
+}
+
+// compare lists
+bool sameEvents(const vector<Event>& a, const vector<Event>& b)
+{
+    if (a.size() != b.size())
+        return false;
+
+    for (size_t i = 0; i < a.size(); i++)
+        if (a[i] != b[i] || a[i].get_id() != b[i].get_id())
+            return false;
+
+    return true;
+}
+
+int main()
+{
+    testMatchesSerial();
+    testOversizedLastEntry();
+    testBadMonthThrows();
+    testMalformed();
+
+    return testResult("parallel_list");
+}
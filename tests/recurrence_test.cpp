@@ -0,0 +1,198 @@
+// includes
+
+#include <string>
+#include <string_view>
+#include "../event/event.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::string_view;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: finds the minutes since 1970 of a date and time
+// requires: the date and time
+// returns: the minutes
+long long minutes(int year, Months, int day, int hour, int minute);
+
+// purpose: finds the day of the week of a time, 0 for Sunday
+// requires: minutes since 1970
+// returns: the day
+int weekday(long long);
+
+// purpose: writes a rule as text
+// requires: the rule
+// returns: the text
+string ruleText(const Recurrence&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// rules read back the way they're written, and what isn't one is turned
+// down
+void testReadWrite()
+{
+    string_view rules[] = { "FREQ=DAILY", "FREQ=WEEKLY;INTERVAL=3",
+        "FREQ=MONTHLY;INTERVAL=2;BYDAY=-1FR;UNTIL=20271231T235900",
+        "FREQ=MONTHLY;BYDAY=2TU", "FREQ=YEARLY;BYMONTHDAY=29",
+        "FREQ=DAILY;UNTIL=20230105T093000" };
+    string_view bad[] = { "", "hourly", "FREQ=HOURLY", "INTERVAL=2",
+        "FREQ=DAILY;INTERVAL=0", "FREQ=WEEKLY;BYDAY=XX",
+        "FREQ=MONTHLY;BYDAY=5MO", "FREQ=DAILY;FOO=1" };
+    Recurrence rule;
+
+    for (auto i : rules)
+        CHECK(ruleText(parseRecurrence(i)) == i);
+
+    CHECK(ruleText(parseRecurrence("weekly")) == "FREQ=WEEKLY");
+    CHECK(parseRecurrence("RRULE:FREQ=DAILY") == parseRecurrence("daily"));
+    CHECK(ruleText(parseRecurrence("FREQ=DAILY;UNTIL=20271231"))
+        == "FREQ=DAILY;UNTIL=20271231T235900");
+
+    rule.interval = 7;
+    for (auto i : bad)
+        CHECK(!readRecurrence(i, rule) && rule.interval == 7);
+}
+
+// the nth and last weekday of each month are the ones found by counting
+void testNthWeekday()
+{
+    for (int week : { 1, 2, 3, 4, -1 })
+    {
+        for (int day = 0; day < 7; day++)
+        {
+            Recurrence rule;
+            long long due = minutes(2023, Months::January, 15, 9, 30);
+
+            rule.frequency = Frequency::Monthly;
+            rule.week = static_cast<std::int8_t>(week);
+            rule.weekday = static_cast<std::uint8_t>(day);
+
+            for (int month = 0; month < 36; month++)
+            {
+                Months expected = static_cast<Months>((month + 1) % 12 + 1);
+
+                CHECK(nextOccurrence(rule, due));
+
+                TimePoint next = TimePoint::fromMinutes(due);
+                int last = TimePoint::daysInMonth(next.month, next.year);
+
+                CHECK(next.month == expected);
+                CHECK(weekday(due) == day);
+                CHECK(next.hour == 9 && next.minute == 30);
+                CHECK(week < 0 ? next.day + 7 > last
+                    : (next.day - 1) / 7 + 1 == week);
+            }
+        }
+    }
+}
+
+// the 31st is the last day of a shorter month, and comes back as the 31st
+// if the rule says so
+void testMonthEnds()
+{
+    Recurrence rule = parseRecurrence("monthly");
+    long long due = minutes(2023, Months::January, 31, 8, 0);
+
+    CHECK(nextOccurrence(rule, due));
+    CHECK(due == minutes(2023, Months::February, 28, 8, 0));
+    CHECK(nextOccurrence(rule, due));
+    CHECK(due == minutes(2023, Months::March, 28, 8, 0));
+
+    rule = parseRecurrence("FREQ=MONTHLY;BYMONTHDAY=31");
+    due = minutes(2024, Months::January, 31, 8, 0);
+
+    CHECK(nextOccurrence(rule, due));
+    CHECK(due == minutes(2024, Months::February, 29, 8, 0));
+    CHECK(nextOccurrence(rule, due));
+    CHECK(due == minutes(2024, Months::March, 31, 8, 0));
+    CHECK(nextOccurrence(rule, due));
+    CHECK(due == minutes(2024, Months::April, 30, 8, 0));
+
+    rule = parseRecurrence("FREQ=YEARLY;BYMONTHDAY=29");
+    due = minutes(2024, Months::February, 29, 12, 0);
+
+    for (int year = 2025; year <= 2028; year++)
+    {
+        CHECK(nextOccurrence(rule, due));
+        CHECK(due == minutes(year, Months::February, year % 4 ? 28 : 29,
+            12, 0));
+    }
+}
+
+// a rule stops after its until, and one that doesn't repeat never moves
+void testUntil()
+{
+    Recurrence rule = parseRecurrence("FREQ=DAILY;UNTIL=20230105T093000");
+    long long due = minutes(2023, Months::January, 3, 9, 30);
+
+    CHECK(nextOccurrence(rule, due));
+    CHECK(nextOccurrence(rule, due));
+    CHECK(due == minutes(2023, Months::January, 5, 9, 30));
+    CHECK(!nextOccurrence(rule, due));
+    CHECK(due == minutes(2023, Months::January, 5, 9, 30));
+    CHECK(!nextOccurrence(Recurrence(), due));
+}
+
+// an event moves on to its next occurrence and keeps its rule
+void testEvent()
+{
+    Event once("once", TimePoint::fromMinutes(
+        minutes(2023, Months::May, 1, 9, 0)));
+    Event weekly = once;
+
+    weekly.set_repeat(parseRecurrence("FREQ=WEEKLY;INTERVAL=2"));
+
+    CHECK(!once.next_occurrence());
+    CHECK(weekly.next_occurrence());
+    CHECK(weekly.get_due_minutes() == minutes(2023, Months::May, 15, 9, 0));
+    CHECK(weekly.get_repeat() == parseRecurrence("FREQ=WEEKLY;INTERVAL=2"));
+
+    weekly.set_repeat(Recurrence());
+    CHECK(weekly.get_schedule() == once.get_schedule());
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// minutes of a date
+long long minutes(int year, Months month, int day, int hour, int minute)
+{
+    return TimePoint(year, month, day, hour, minute).toMinutes();
+}
+
+// day of the week
+int weekday(long long time)
+{
+    // 1970/01/01 was a Thursday
+    return static_cast<int>((time / 1440 + 4) % 7);
+}
+
+// rule text
+string ruleText(const Recurrence& rule)
+{
+    char text[RECURRENCE_TEXT_SIZE];
+
+    return string(text, formatRecurrence(text, rule));
+}
+
+int main()
+{
+    testReadWrite();
+    testNthWeekday();
+    testMonthEnds();
+    testUntil();
+    testEvent();
+
+    return testResult("recurrence");
+}
@@ -0,0 +1,80 @@
+// includes
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../view/render.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// the buffered render lays every event out byte for byte like operator<<
+void testMatchesStream()
+{
+    vector<Event> events;
+    double biases[] = { 0.0, 0.1, -0.5, 1e-7, 123456789.0, 2.5e300 };
+    std::ostringstream rendered;
+    std::ostringstream streamed;
+
+    NOW = TimePoint::fromMinutes(28000000);
+
+    for (int i = 0; i < 60; i++)
+    {
+        // from far overdue, where the priority is held, to far off
+        events.emplace_back(i % 3 ? "title " + std::to_string(i) : "",
+            TimePoint::fromMinutes(28000000 + (i - 30) * 600LL),
+            1 + i % 9, biases[i % 6], i % 2 ? "" : "a\tdescription");
+
+        if (i % 4 == 1)
+            events.back().set_zone(ZONES.find("Europe/London"));
+        if (i % 5 == 2)
+            events.back().set_repeat(parseRecurrence(
+                "FREQ=MONTHLY;BYDAY=-1FR;UNTIL=20301231"));
+    }
+
+    writeList(rendered, events);
+
+    for (auto &i : events)
+    {
+        std::ostringstream one;
+
+        one << i;
+        CHECK(renderSizeHint(i) >= one.str().size());
+
+        streamed << one.str() << '\n';
+    }
+
+    CHECK(rendered.str() == streamed.str());
+}
+
+// the size hint is never short, so the buffer never grows
+void testSizeHint()
+{
+    Event event("a title", TimePoint(2023, Months::May, 1, 9, 0), 7,
+        -123.456, "and a description");
+    std::ostringstream streamed;
+
+    event.set_zone(ZONES.find("America/Argentina/ComodRivadavia"));
+    event.set_repeat(parseRecurrence(
+        "FREQ=MONTHLY;INTERVAL=12;BYDAY=-1WE;BYMONTHDAY=31;UNTIL=20991231"));
+    streamed << event;
+
+    CHECK(renderSizeHint(event) >= streamed.str().size());
+}
+
+int main()
+{
+    testMatchesStream();
+    testSizeHint();
+
+    return testResult("render");
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+# builds and runs every test in this directory, each is a single
+# translation unit like main.cpp
+# usage: tests/run_tests.sh [compiler flags...]
+
+cd "$(dirname "$0")" || exit 1
+
+out="${TMPDIR:-/tmp}/todo_tests"
+failed=0
+
+mkdir -p "$out"
+
+for test in *_test.cpp
+do
+    name="${test%.cpp}"
+
+    if ! ${CXX:-g++} -std=c++17 -Wall -O1 -pthread -I.. "$@" "$test" \
+        -o "$out/$name"
+    then
+        echo "$name: did not build"
+        failed=1
+    elif ! (cd "$out" && "./$name")
+    then
+        failed=1
+    fi
+done
+
+exit $failed
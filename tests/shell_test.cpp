@@ -0,0 +1,376 @@
+// includes
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../shell.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the list the shell in the test opens, next to the test, and the store
+// the shell keeps beside it
+const string LIST_FILE = "shell_test.json";
+const string STORE_FILE = "shell_test.bin";
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: writes a list file with events due an hour apart, the first
+//          one due first
+// requires: how many events
+// returns: nothing
+void writeList(int count);
+
+// purpose: runs a command line and catches what it prints
+// requires: the shell and the command line
+// returns: what it printed
+string run(Shell&, vector<string>);
+
+// purpose: counts how many times some text shows up
+// requires: the text and what to look for
+// returns: the count
+int count(const string&, const string&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// options can go anywhere on the line and the keywords close up around
+// them, and a line that's only options is missing its command
+void testOptions()
+{
+    writeList(5);
+
+    Shell shell(LIST_FILE);
+
+    CHECK(count(run(shell, { "view", "list" }), "Due by") == 5);
+    CHECK(count(run(shell, { "view", "--limit", "2", "list" }),
+        "Due by") == 2);
+    CHECK(count(run(shell, { "--limit=3", "view", "list" }), "Due by") == 3);
+    CHECK(count(run(shell, { "view", "list", "--after", "2" }),
+        "Due by") == 3);
+    CHECK(run(shell, { "view", "list", "--limit", "2" }).find(
+        "-- more: --after 2 --") != string::npos);
+    CHECK(run(shell, { "view", "--format", "jsonl", "top" }).find(
+        "event 1") != string::npos);
+
+    CHECK(run(shell, { "--format", "jsonl" }).find(
+        "The options need a command") != string::npos);
+    CHECK(run(shell, { "--limit" }).find(
+        "The options need a command") != string::npos);
+    CHECK(shell.isRunning());
+}
+
+// following the pages of the list shows every event once, most important
+// first, and a page can only start after an event that's there
+void testPaging()
+{
+    writeList(7);
+
+    Shell shell(LIST_FILE);
+    string shown;
+    string after;
+    size_t more;
+
+    // each page says where the next one starts, until the last one
+    do
+    {
+        vector<string> cmd_line = { "view", "list", "--limit", "3" };
+        string page;
+
+        if (!after.empty())
+            cmd_line.insert(cmd_line.end(), { "--after", after });
+
+        page = run(shell, cmd_line);
+        more = page.find("-- more: --after ");
+
+        if (more != string::npos)
+            after = page.substr(more + 17, page.find(' ', more + 17)
+                - more - 17);
+        CHECK(count(page, "Due by") == (more != string::npos ? 3 : 1));
+        shown += page;
+    } while (more != string::npos && count(shown, "Due by") < 10);
+
+    CHECK(count(shown, "Due by") == 7);
+    for (int i = 1; i < 7; i++)
+        CHECK(shown.find("event " + std::to_string(i) + "\n")
+            < shown.find("event " + std::to_string(i + 1) + "\n"));
+
+    // a finished event isn't somewhere a page can start
+    run(shell, { "finish", "top" });
+    CHECK(run(shell, { "view", "list", "--after", "1" }).find(
+        "Event 1 not found") != string::npos);
+    CHECK(count(run(shell, { "view", "list", "--after", "2" }),
+        "Due by") == 5);
+    CHECK(run(shell, { "view", "list", "--limit", "-1" }).find(
+        "The limit can't be negative") != string::npos);
+}
+
+// an import goes onto the list in one go, and the events get ids of
+// their own
+void testImport()
+{
+    const string csv = "shell_test.csv";
+
+    writeList(3);
+
+    {
+        std::ofstream file(csv);
+
+        file << "title,description,importance,bias,due\n";
+        for (int i = 0; i < 50; i++)
+            file << "imported " << i << ",,2,0,06 30 2023 17 00\n";
+    }
+
+    Shell shell(LIST_FILE);
+
+    CHECK(run(shell, { "import", csv }).find("Imported 50 events")
+        != string::npos);
+    CHECK(count(run(shell, { "view", "list" }), "Due by") == 53);
+    CHECK(run(shell, { "view", "list", "--after", "54" }).find(
+        "not found") != string::npos);
+    CHECK(run(shell, { "view", "list", "--after", "53" }).find(
+        "not found") == string::npos);
+
+    // the imported events are the most overdue, so they're on top
+    CHECK(run(shell, { "view", "top" }).find("imported ") != string::npos);
+
+    std::remove(csv.c_str());
+}
+
+// a reload gives the list's strings back and reads the saved list again,
+// with the changes made before it
+void testReload()
+{
+    writeList(5);
+
+    Shell shell(LIST_FILE);
+
+    // strings the list doesn't use any more, like a finished event's
+    for (int i = 0; i < 20000; i++)
+        LIST_ARENA.store("left over " + std::to_string(i));
+    run(shell, { "finish", "top" });
+    CHECK(LIST_ARENA.bytesReserved() > ARENA_BLOCK_SIZE);
+
+    CHECK(count(run(shell, { "reload" }), "wasn't reloaded") == 0);
+    CHECK(count(run(shell, { "view", "list" }), "Due by") == 4);
+    CHECK(run(shell, { "view", "top" }).find("event 2") != string::npos);
+    CHECK(LIST_ARENA.bytesReserved() == ARENA_BLOCK_SIZE);
+}
+
+// the list file is saved from the events, so it always has what the
+// shell has
+void testSavedList()
+{
+    string text;
+    vector<Event> saved;
+
+    writeList(4);
+
+    {
+        Shell shell(LIST_FILE);
+
+        run(shell, { "finish", "top" });
+        run(shell, { "edit", "3", "bias", "2.5" });
+    }
+
+    CHECK(readFileText(LIST_FILE, text));
+    CHECK(readListEvents(text, saved));
+    CHECK(saved.size() == 3);
+
+    for (auto &i : saved)
+    {
+        CHECK(i.get_id() != 1);
+        CHECK(i.get_bias() == (i.get_id() == 3 ? 2.5 : 0.0));
+    }
+}
+
+// the shell works priorities out from the clock in use, and catches up
+// when it moves
+void testClock()
+{
+    FixedClock pinned(TimePoint(2030, Months::June, 15, 8, 0));
+
+    // the list is written from the pinned time too
+    useClock(pinned);
+    NOW = pinned.now();
+    writeList(3);
+
+    Shell shell(LIST_FILE);
+    string before = run(shell, { "view", "top" });
+
+    CHECK(NOW == pinned.now());
+
+    // the events are due from an hour after the old time, so they're all
+    // overdue now, and more important
+    pinned.advance(60 * 24);
+    string after = run(shell, { "view", "top" });
+
+    CHECK(NOW == pinned.now());
+    CHECK(before.find("event 1") != string::npos);
+    CHECK(after.find("event 1") != string::npos);
+    CHECK(before != after);
+
+    useClock(SYSTEM_CLOCK);
+}
+
+// the top of an empty list can't be looked at or finished
+void testEmptyList()
+{
+    writeList(1);
+
+    Shell shell(LIST_FILE);
+
+    CHECK(run(shell, { "finish", "top" }).find("The list is empty")
+        == string::npos);
+    CHECK(run(shell, { "finish", "top" }).find("The list is empty")
+        != string::npos);
+    CHECK(run(shell, { "view", "top" }).find("The list is empty")
+        != string::npos);
+    CHECK(count(run(shell, { "view", "list" }), "Due by") == 0);
+}
+
+// the top of an empty list store can't be looked at either
+void testEmptyStore()
+{
+    writeList(1);
+
+    // the store is saved along with the list once it's empty
+    {
+        Shell shell(LIST_FILE);
+
+        run(shell, { "finish", "top" });
+    }
+
+    Shell shell(LIST_FILE, Shell::ReadOnly);
+
+    CHECK(run(shell, { "view", "top" }).find("The list is empty")
+        != string::npos);
+    CHECK(count(run(shell, { "view", "list" }), "Due by") == 0);
+}
+
+// a zone that can't be found is turned down, however many are tried
+void testEditZone()
+{
+    writeList(1);
+
+    Shell shell(LIST_FILE);
+
+    for (int i = 0; i < 2 * static_cast<int>(ZONE_LIMIT); i++)
+        CHECK(run(shell, { "edit", "1", "zone",
+            "No/Such_Zone_" + std::to_string(i) }).find("not found")
+            != string::npos);
+
+    CHECK(run(shell, { "edit", "1", "zone", "Asia/Tokyo" }).find(
+        "not found") == string::npos);
+}
+
+// the save made while the shell starts up is already minified
+void testMinifiedStartup()
+{
+    for (bool minified : { false, true })
+    {
+        vector<Event> heap;
+        string text;
+
+        writeList(2);
+        heap.emplace_back("event 3",
+            TimePoint::fromMinutes(NOW.toMinutes() + 180));
+
+        // the shell saves what it was handed, and is done by the time
+        // it closes
+        {
+            Shell shell(LIST_FILE, heap, minified);
+        }
+
+        std::ifstream file(LIST_FILE);
+        std::getline(file, text, '\0');
+
+        CHECK(count(text, "\"title\"") == 3);
+        CHECK((text.find("\n    ") == string::npos) == minified);
+    }
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// write a list file
+void writeList(int count)
+{
+    vector<Event> events;
+    std::ofstream file(LIST_FILE);
+
+    std::remove(STORE_FILE.c_str());
+
+    for (int i = 1; i <= count; i++)
+    {
+        events.emplace_back("event " + std::to_string(i),
+            TimePoint::fromMinutes(NOW.toMinutes() + i * 60));
+        events.back().set_id(static_cast<unsigned>(i));
+    }
+
+    writeListJSON(file, events, false);
+}
+
+// run a command line
+string run(Shell& shell, vector<string> cmd_line)
+{
+    std::ostringstream printed;
+    std::streambuf* console = cout.rdbuf(printed.rdbuf());
+
+    shell.runCommand(std::move(cmd_line));
+    cout.rdbuf(console);
+
+    return printed.str();
+}
+
+// count some text
+int count(const string& text, const string& what)
+{
+    int found = 0;
+
+    for (size_t i = text.find(what); i != string::npos;
+        i = text.find(what, i + 1))
+        found++;
+
+    return found;
+}
+
+int main()
+{
+    // the shell prints its commands when it opens
+    std::ostringstream ignored;
+    std::streambuf* console = cout.rdbuf(ignored.rdbuf());
+
+    testOptions();
+    testPaging();
+    testImport();
+    testReload();
+    testSavedList();
+    testClock();
+    testEmptyList();
+    testEmptyStore();
+    testEditZone();
+    testMinifiedStartup();
+
+    cout.rdbuf(console);
+
+    return testResult("shell");
+}
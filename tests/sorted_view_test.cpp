@@ -0,0 +1,147 @@
+// includes
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../view/sorted_view.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: checks the view holds the list in the order the event
+//          operators put it in
+// requires: the view and the list
+// returns: true if it does
+bool inOrder(const SortedView&, vector<Event>);
+
+// purpose: checks every event is found by its position and by its id
+// requires: the view
+// returns: true if they all are
+bool positionsFound(const SortedView&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// adding and finishing events one at a time keeps the view in order,
+// across many blocks and with ties on priority and due date
+void testInsertErase()
+{
+    std::mt19937 random(7);
+    vector<Event> list;
+    SortedView view;
+
+    NOW = TimePoint::fromMinutes(28000000);
+
+    for (unsigned i = 1; i <= 3000; i++)
+    {
+        // few due dates, so lots of events tie up to their titles
+        list.emplace_back("event " + std::to_string(i), TimePoint::fromMinutes(
+            28000000 + static_cast<long long>(random() % 40) * 60 - 1200),
+            1 + random() % 3);
+        list.back().set_id(i);
+
+        if (i == 1000)
+            view.rebuild(list, NOW);
+        else if (i > 1000)
+            view.insert(list.back());
+    }
+
+    CHECK(inOrder(view, list));
+    CHECK(positionsFound(view));
+
+    for (int i = 0; i < 2500; i++)
+    {
+        size_t at = random() % list.size();
+
+        view.erase(list[at]);
+        list.erase(list.begin() + at);
+    }
+
+    CHECK(inOrder(view, list));
+    CHECK(!view.needsRebuild(NOW));
+    CHECK(positionsFound(view));
+}
+
+// each page starts right after the last event of the one before
+void testPaging()
+{
+    vector<Event> list;
+    SortedView view;
+
+    NOW = TimePoint::fromMinutes(28000000);
+
+    for (unsigned i = 1; i <= 600; i++)
+    {
+        list.emplace_back("page " + std::to_string(i), TimePoint::fromMinutes(
+            28000000 + (i % 50) * 30));
+        list.back().set_id(i);
+    }
+
+    view.rebuild(list, NOW);
+
+    size_t pos = 0;
+
+    for (auto i = view.begin(); i != view.end(); ++i)
+        CHECK(view.positionAfter(i->get_id()) == ++pos);
+
+    CHECK(view.positionAfter(601) == SortedView::npos);
+    CHECK(view.at(pos) == view.end());
+}
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// compare the view with a sort
+bool inOrder(const SortedView& view, vector<Event> list)
+{
+    std::sort(list.begin(), list.end(), std::greater<Event>());
+
+    if (view.size() != list.size())
+        return false;
+
+    auto i = view.begin();
+
+    for (auto &j : list)
+    {
+        if (i->get_id() != j.get_id())
+            return false;
+        ++i;
+    }
+
+    return i == view.end();
+}
+
+// look every event up
+bool positionsFound(const SortedView& view)
+{
+    size_t pos = 0;
+
+    for (auto i = view.begin(); i != view.end(); ++i, ++pos)
+        if (view.at(pos)->get_id() != i->get_id()
+            || view.positionAfter(i->get_id()) != pos + 1)
+            return false;
+
+    return pos == view.size() && view.at(pos) == view.end();
+}
+
+int main()
+{
+    testInsertErase();
+    testPaging();
+
+    return testResult("sorted_view");
+}
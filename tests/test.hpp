@@ -0,0 +1,66 @@
+#pragma once
+
+
+// includes
+
+#include <iostream>
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// how many checks have failed so far
+int TEST_FAILURES = 0;
+
+
+    /**********\
+    *  checks  *
+    \**********/
+
+// purpose: checks something is true, printing where it wasn't
+// requires: the condition
+// returns: nothing, the failure is counted for testResult
+#define CHECK(condition) \
+    checkThat((condition), #condition, __FILE__, __LINE__)
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: counts and prints a failed check
+// requires: the result, its text, and where it is
+// returns: the result
+bool checkThat(bool, const char*, const char*, int);
+
+// purpose: prints how the checks went
+// requires: the name of the test
+// returns: the exit code, 0 if every check passed
+int testResult(const char*);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// count a failed check
+bool checkThat(bool passed, const char* text, const char* file, int line)
+{
+    if (!passed)
+    {
+        TEST_FAILURES++;
+        std::cerr << file << ":" << line << ": failed: " << text << "\n";
+    }
+
+    return passed;
+}
+
+// sum up
+int testResult(const char* name)
+{
+    std::cout << name << ": " << (TEST_FAILURES == 0 ? "passed" : "FAILED")
+        << " (" << TEST_FAILURES << " failed checks)\n";
+
+    return TEST_FAILURES == 0 ? 0 : 1;
+}
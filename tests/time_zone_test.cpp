@@ -0,0 +1,227 @@
+// includes
+
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include "../event/time_zone.hpp"
+#include "../event/timepoint.hpp"
+#include "test.hpp"
+
+
+// usings
+
+using std::string;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: finds the seconds since 1970 of a time in UTC
+// requires: the date and time
+// returns: the seconds
+long long utc(int year, Months, int day, int hour, int minute);
+
+// purpose: loads a zone from the system's zone files
+// requires: the zone and its name
+// returns: false if the system doesn't have it
+bool loadSystemZone(TimeZone&, const string&);
+
+
+    /*********\
+    *  tests  *
+    \*********/
+
+// New York changes over on the days the law says, in the years its file
+// lists and in the years its rule works out
+void testTransitions()
+{
+    TimeZone york("America/New_York");
+
+    if (!loadSystemZone(york, "America/New_York"))
+        return;
+
+    struct Change
+    {
+        long long at;
+        int before;
+        int after;
+    } changes[] = {
+        // the year round daylight time of the energy crisis
+        { utc(1974, Months::January, 6, 7, 0), -18000, -14400 },
+        { utc(2006, Months::April, 2, 7, 0), -18000, -14400 },
+        { utc(2007, Months::March, 11, 7, 0), -18000, -14400 },
+        { utc(2023, Months::March, 12, 7, 0), -18000, -14400 },
+        { utc(2023, Months::November, 5, 6, 0), -14400, -18000 },
+        { utc(2030, Months::March, 10, 7, 0), -18000, -14400 },
+        { utc(2030, Months::November, 3, 6, 0), -14400, -18000 },
+        { utc(2199, Months::March, 10, 7, 0), -18000, -14400 }
+    };
+
+    for (auto &i : changes)
+    {
+        CHECK(york.offsetAt(i.at - 1) == i.before);
+        CHECK(york.offsetAt(i.at) == i.after);
+    }
+}
+
+// a time skipped in spring is moved past the gap, one that happens twice
+// in the fall is taken the first time, and any local time goes there and
+// back
+void testLocalTime()
+{
+    TimeZone york("America/New_York");
+    bool same = true;
+
+    if (!loadSystemZone(york, "America/New_York"))
+        return;
+
+    long long skipped = utc(2023, Months::March, 12, 2, 30) / 60;
+    long long twice = utc(2023, Months::November, 5, 1, 30) / 60;
+
+    CHECK(york.toUTC(skipped) == utc(2023, Months::March, 12, 7, 30) / 60);
+    CHECK(york.toLocal(york.toUTC(skipped)) == skipped + 60);
+    CHECK(york.toUTC(twice) == utc(2023, Months::November, 5, 5, 30) / 60);
+
+    for (long long m = 0; m < 70LL * 525960; m += 997)
+    {
+        long long local = york.toLocal(m);
+
+        same = same && york.toLocal(york.toUTC(local)) == local;
+    }
+
+    CHECK(same);
+}
+
+// the zone gives the offsets the system's own conversion does, every
+// few hours for the years a 32-bit time_t can hold
+void testMatchesSystem()
+{
+#ifndef _WIN32
+    for (const char* name : { "America/New_York", "Europe/London",
+        "Australia/Sydney", "Asia/Kolkata", "America/Sao_Paulo" })
+    {
+        TimeZone zone(name);
+        bool same = true;
+
+        if (!loadSystemZone(zone, name))
+            continue;
+
+        setenv("TZ", name, 1);
+        tzset();
+
+        for (long long t = 0; t < INT32_MAX; t += 10007)
+        {
+            std::time_t at = static_cast<std::time_t>(t);
+            std::tm local;
+
+            localtime_r(&at, &local);
+            same = same && zone.offsetAt(t) == local.tm_gmtoff;
+        }
+
+        CHECK(same);
+    }
+
+    unsetenv("TZ");
+    tzset();
+#endif
+}
+
+// a POSIX rule on its own gives the same changes as the zone file, north
+// and south of the equator, and what isn't one is turned down
+void testPosixRules()
+{
+    TimeZone rule("EST5EDT");
+    TimeZone south("AEST-10AEDT");
+    TimeZone york("America/New_York");
+    TimeZone sydney("Australia/Sydney");
+    PosixRule read;
+
+    CHECK(rule.loadRule("EST5EDT,M3.2.0,M11.1.0"));
+    CHECK(south.loadRule("AEST-10AEDT,M10.1.0,M4.1.0/3"));
+
+    if (loadSystemZone(york, "America/New_York")
+        && loadSystemZone(sydney, "Australia/Sydney"))
+    {
+        bool same = true;
+
+        for (long long t = utc(2008, Months::January, 1, 0, 0);
+            t < utc(2038, Months::January, 1, 0, 0); t += 3607)
+            same = same && rule.offsetAt(t) == york.offsetAt(t)
+                && south.offsetAt(t) == sydney.offsetAt(t);
+
+        CHECK(same);
+    }
+
+    CHECK(readPosixRule("JST-9", read) && !read.hasDaylight);
+    CHECK(read.standard == 9 * 3600);
+    CHECK(readPosixRule("<+0530>-5:30", read) && read.standard == 19800);
+    CHECK(readPosixRule("EST5EDT,J60/2,300/-1", read) && read.hasDaylight);
+    CHECK(read.start.kind == 'J' && read.end.time == -3600);
+
+    for (string_view i : { "", "5EST", "EST", "ES5", "EST5EDT,M13.1.0,M11.1.0",
+        "EST5EDT,M3.6.0,M11.1.0", "EST5EDT,M3.2.7,M11.1.0", "EST5EDT,J0,J9",
+        "EST5EDT,M3.2.0", "EST5EDT,M3.2.0,M11.1.0,x" })
+        CHECK(!readPosixRule(i, read));
+}
+
+// the table reads each zone once, and a name that isn't a zone, or
+// climbs out of the zone directory, floats without taking up a place
+void testTable()
+{
+    ZoneTable table;
+    ZoneId york = table.find("America/New_York");
+    ZoneId tokyo = table.find("Asia/Tokyo");
+    long long noon = utc(2023, Months::July, 1, 12, 0) / 60;
+
+    CHECK(table.find("") == 0);
+    CHECK(table.find("No/Such_Zone") == 0);
+    CHECK(table.find("../zoneinfo/Asia/Tokyo") == 0);
+    CHECK(table.find("America/New_York") == york);
+
+    if (york == 0 || tokyo == 0)
+        return;
+
+    CHECK(york != tokyo);
+    CHECK(table.zone(york).name() == "America/New_York");
+    CHECK(table.zone(york).isLoaded());
+    CHECK(table.convert(noon, york, tokyo) == noon + 13 * 60);
+
+    // names that aren't zones can be looked up any number of times
+    for (int i = 0; i < 2 * static_cast<int>(ZONE_LIMIT); i++)
+        CHECK(table.find("No/Such_Zone_" + std::to_string(i)) == 0);
+
+    CHECK(table.find("Europe/Paris") != 0);
+}
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// seconds of a time in utc
+long long utc(int year, Months month, int day, int hour, int minute)
+{
+    return TimePoint(year, month, day, hour, minute).toMinutes() * 60;
+}
+
+// load a system zone
+bool loadSystemZone(TimeZone& zone, const string& name)
+{
+    if (zone.load(string(ZONE_INFO_DIR) + "/" + name))
+        return true;
+
+    std::cerr << "no zone file for " << name << ", skipped\n";
+
+    return false;
+}
+
+int main()
+{
+    testTransitions();
+    testLocalTime();
+    testMatchesSystem();
+    testPosixRules();
+    testTable();
+
+    return testResult("time_zone");
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+
+// includes
+
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../event/event.hpp"
+#include "../io/json_writer.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: writes an event as one compact json object, with its id and
+//          its priority (null when the priority isn't a finite number)
+// requires: a json writer and an event
+// returns: nothing
+void writeEventJSON(JSONWriter&, const Event&);
+
+// purpose: writes each event as a json object on its own line,
+//          all in one write to the stream
+// requires: an output stream and the events
+// returns: nothing
+void writeJSONLines(std::ostream&, const vector<Event>&);
+
+// purpose: writes a range of events as json lines
+// requires: an output stream and two iterators
+// returns: nothing
+template <typename iter>
+void writeJSONLines(std::ostream&, iter first, iter last);
+
+// purpose: writes one event as a json line
+// requires: an output stream and the event
+// returns: nothing
+void writeJSONLine(std::ostream&, const Event&);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// write an event as a json object
+void writeEventJSON(JSONWriter& writer, const Event& thing)
+{
+    TimePoint due = thing.get_due_date();
+
+    writer.beginObject();
+    writer.key("id");
+    writer.value(thing.id);
+    writer.key("title");
+    writer.value(TITLES.name(thing.title));
+    writer.key("description");
+    writer.value(DESCRIPTIONS.get(thing.details));
+    writer.key("importance");
+    writer.value(thing.importance);
+    writer.key("bias");
+    writer.value(thing.bias);
+    writer.key("priority");
+    writer.value(thing.priority);
+
+    writer.key("due_date");
+    writer.beginObject();
+    writer.key("year");
+    writer.value(due.year);
+    writer.key("month");
+    writer.value(mtos(due.month));
+    writer.key("day");
+    writer.value(due.day);
+    writer.key("hour");
+    writer.value(due.hour);
+    writer.key("minute");
+    writer.value(due.minute);
+    writer.endObject();
+
+    if (thing.get_zone() != 0)
+    {
+        writer.key("time_zone");
+        writer.value(ZONES.zone(thing.get_zone()).name());
+    }
+
+    if (thing.is_recurring())
+    {
+        char text[RECURRENCE_TEXT_SIZE];
+
+        writer.key("repeat");
+        writer.value(string_view(text,
+            formatRecurrence(text, thing.get_repeat()) - text));
+    }
+
+    writer.endObject();
+}
+
+// write the events as json lines
+void writeJSONLines(std::ostream& os, const vector<Event>& events)
+{
+    writeJSONLines(os, events.begin(), events.end());
+}
+
+// write a range of events as json lines
+template <typename iter>
+void writeJSONLines(std::ostream& os, iter first, iter last)
+{
+    string buffer;
+
+    // a rough guess so the buffer rarely has to grow
+    buffer.reserve(static_cast<size_t>(std::distance(first, last)) * 256);
+
+    for (iter i = first; i != last; ++i)
+    {
+        JSONWriter writer(buffer);
+        writeEventJSON(writer, *i);
+        buffer.push_back('\n');
+    }
+
+    os.write(buffer.data(), buffer.size());
+    os.flush();
+}
+
+// write a single event as a json line
+void writeJSONLine(std::ostream& os, const Event& thing)
+{
+    string buffer;
+    JSONWriter writer(buffer);
+
+    writeEventJSON(writer, thing);
+    buffer.push_back('\n');
+
+    os.write(buffer.data(), buffer.size());
+    os.flush();
+}
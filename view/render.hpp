@@ -0,0 +1,163 @@
+#pragma once
+
+
+// includes
+
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../event/event.hpp"
+
+
+// usings
+
+using std::string;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// room for everything in a rendered event besides the title and description
+constexpr size_t RENDER_OVERHEAD = 96;
+
+
+    /**************\
+    *  prototypes  *
+    \**************/
+
+// purpose: appends a double the same way an ostream prints it by default
+// requires: a buffer and a double
+// returns: nothing
+void appendNumber(string&, double);
+
+// purpose: appends a time point as YYYY/MM/DD HHMM
+// requires: a buffer and a time point
+// returns: nothing
+void renderTimePoint(string&, const TimePoint&);
+
+// purpose: finds roughly how many bytes an event renders to
+// requires: an event
+// returns: the size, never less than the real one for sane numbers
+size_t renderSizeHint(const Event&);
+
+// purpose: renders every event into one pre-sized buffer and writes it
+//          to the stream with a single call, each followed by a blank line
+// requires: an output stream and the events
+// returns: nothing
+void writeList(std::ostream&, const vector<Event>&);
+
+// purpose: renders a range of events like writeList
+// requires: an output stream and two iterators
+// returns: nothing
+template <typename iter>
+void writeList(std::ostream&, iter first, iter last);
+
+
+    /***************\
+    *  definitions  *
+    \***************/
+
+// append a double like operator<< would
+void appendNumber(string& out, double value)
+{
+    char digits[32];
+
+    // the default ostream format is %g with six significant digits
+    auto result = std::to_chars(digits, digits + sizeof(digits), value,
+        std::chars_format::general, 6);
+
+    out.append(digits, result.ptr);
+}
+
+// append a time point
+void renderTimePoint(string& out, const TimePoint& p)
+{
+    char text[TIME_POINT_TEXT_SIZE];
+
+    out.append(text, p.format(text));
+}
+
+// append an event
+void renderEvent(string& out, const Event& thing)
+{
+    string_view description = DESCRIPTIONS.get(thing.details);
+    char importance[8];
+
+    out += TITLES.name(thing.title);
+
+    if (!description.empty())
+    {
+        out += "\n\t";
+        out += description;
+    }
+
+    out += "\nDue by ";
+    renderTimePoint(out, thing.get_due_date());
+    if (thing.get_zone() != 0)
+    {
+        out += ' ';
+        out += ZONES.zone(thing.get_zone()).name();
+    }
+
+    if (thing.is_recurring())
+    {
+        char text[RECURRENCE_TEXT_SIZE];
+
+        out += "\nRepeats: ";
+        out.append(text, formatRecurrence(text, thing.get_repeat()));
+    }
+
+    out += "\nImportance: ";
+    out.append(importance, std::to_chars(importance,
+        importance + sizeof(importance), thing.importance).ptr);
+
+    out += "\nBias: ";
+    appendNumber(out, thing.bias);
+
+    out += "\nPriority Level: ";
+    appendNumber(out, thing.get_priority());
+    out += "\n";
+}
+
+// estimate the rendered size of an event
+size_t renderSizeHint(const Event& thing)
+{
+    return TITLES.name(thing.title).size()
+        + DESCRIPTIONS.get(thing.details).size()
+        + (thing.get_zone() != 0
+            ? ZONES.zone(thing.get_zone()).name().size() + 1 : 0)
+        + (thing.is_recurring() ? RECURRENCE_TEXT_SIZE : 0)
+        + RENDER_OVERHEAD;
+}
+
+// write the whole list at once
+void writeList(std::ostream& os, const vector<Event>& events)
+{
+    writeList(os, events.begin(), events.end());
+}
+
+// write a range of the list at once
+template <typename iter>
+void writeList(std::ostream& os, iter first, iter last)
+{
+    string buffer;
+    size_t size = 0;
+
+    // size the buffer up front so it never has to grow
+    for (iter i = first; i != last; ++i)
+        size += renderSizeHint(*i);
+
+    buffer.reserve(size);
+
+    for (iter i = first; i != last; ++i)
+    {
+        renderEvent(buffer, *i);
+        buffer.push_back('\n');
+    }
+
+    os.write(buffer.data(), buffer.size());
+    os.flush();
+}
@@ -0,0 +1,457 @@
+#pragma once
+
+
+// includes
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include "../event/event.hpp"
+
+
+// usings
+
+using std::size_t;
+using std::vector;
+
+
+    /*************\
+    *  constants  *
+    \*************/
+
+// the number of events a block of the sorted view aims to hold
+// blocks split in half when they get twice this big
+constexpr size_t SORTED_BLOCK_SIZE = 256;
+
+
+    /**************\
+    *  SortedView  *
+    \**************/
+
+// a cached copy of the to do list sorted by priority, most important first
+// the events are kept in a list of small sorted blocks, so adding,
+// finishing, or editing an event only shifts one block around, and the
+// sizes of the blocks are kept in a Fenwick tree, so a block is found by
+// position or by key in log time
+// the whole thing is only sorted again when the time the priorities were
+// worked out for moves, or when the shell throws it away
+class SortedView
+{
+    // what's needed to find an event again by its id
+    struct Key
+    {
+        double priority;
+        std::int32_t due;
+    };
+
+public:
+
+    // walks the view in priority order
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Event;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Event*;
+        using reference = const Event&;
+
+        const_iterator(const vector<vector<Event>>* b, size_t bl, size_t o)
+            : blocks(b), block(bl), offset(o) { }
+
+        reference operator*() const { return (*blocks)[block][offset]; }
+        pointer operator->() const { return &**this; }
+
+        // step to the next event, hopping to the next block at the end
+        const_iterator& operator++()
+        {
+            if (++offset == (*blocks)[block].size())
+            {
+                ++block;
+                offset = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return block == other.block && offset == other.offset;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        const vector<vector<Event>>* blocks;
+        size_t block;
+        size_t offset;
+    };
+
+    // returned when a position can't be found
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // purpose: throws the view away, so it's rebuilt the next time
+    // requires: nothing
+    // returns: nothing
+    void invalidate() { stale = true; }
+
+    // purpose: determines if the view needs to be rebuilt
+    // requires: the time priorities are worked out from right now
+    // returns: true if it was thrown away or the time moved
+    bool needsRebuild(const TimePoint& now) const
+    {
+        return stale || reference != now;
+    }
+
+    // purpose: sorts a copy of the list
+    // requires: the list and the time the priorities are worked out from
+    // returns: nothing
+    void rebuild(const vector<Event>&, const TimePoint&);
+
+    // purpose: puts a new event in its place
+    // requires: the event
+    // returns: nothing
+    void insert(const Event&);
+
+    // purpose: takes an event out of the view
+    // requires: the event, as it was when it went in
+    // returns: nothing
+    void erase(const Event&);
+
+    // purpose: gets the number of events in the view
+    // requires: nothing
+    // returns: the size
+    size_t size() const { return count; }
+
+    // purpose: iterators over the events in priority order
+    // requires: nothing
+    // returns: an iterator
+    const_iterator begin() const { return const_iterator(&blocks, 0, 0); }
+    const_iterator end() const
+    {
+        return const_iterator(&blocks, blocks.size(), 0);
+    }
+
+    // purpose: gets an iterator to the event at a position
+    // requires: a position no bigger than the size
+    // returns: an iterator
+    const_iterator at(size_t pos) const;
+
+    // purpose: finds the position right after an event, for paging
+    // requires: the id of the event
+    // returns: the position, or npos if the event isn't in the view
+    size_t positionAfter(unsigned id) const;
+
+private:
+
+    bool stale = true;
+    TimePoint reference;
+    size_t count = 0;
+    vector<vector<Event>> blocks;
+    // the sizes of the blocks as a Fenwick tree, counts[i] adding up the
+    // blocks from i - (i & -i) to i - 1
+    vector<size_t> counts;
+    std::unordered_map<unsigned, Key> keys;
+
+    // purpose: ranks two events the same way the event operators do
+    // requires: two events
+    // returns: true if a comes before b, i.e. a is more important
+    static bool ranksBefore(const Event& a, const Event& b);
+
+    // purpose: ranks by priority and due date only, for looking up an id
+    // requires: an event and a key
+    // returns: true if the event comes before anything with the key
+    static bool keyBefore(const Event& a, const Key& b);
+
+    // purpose: checks if an event has the same priority and due date as a key
+    // requires: an event and a key
+    // returns: a boolean value
+    static bool sameKey(const Event& a, const Key& b)
+    {
+        return a.get_priority() == b.priority && a.get_due_minutes() == b.due;
+    }
+
+    // purpose: finds the block an event belongs in
+    // requires: the event
+    // returns: the index of the block
+    size_t findBlock(const Event&) const;
+
+    // purpose: finds the first block that can hold events with a key
+    // requires: the key
+    // returns: the index of the block, the number of blocks if none can
+    size_t findKeyBlock(const Key&) const;
+
+    // purpose: works the sizes of the blocks out again, for when blocks
+    //          come or go
+    // requires: nothing
+    // returns: nothing
+    void recount();
+
+    // purpose: changes the size a block is counted at
+    // requires: the block and how much it grew, negative if it shrank
+    // returns: nothing
+    void addCount(size_t block, std::ptrdiff_t);
+
+    // purpose: counts the events in the blocks before a block
+    // requires: the block
+    // returns: the count
+    size_t countBefore(size_t block) const;
+};
+
+
+    /**********************\
+    *  SortedView methods  *
+    \**********************/
+
+// sort a copy of the list
+void SortedView::rebuild(const vector<Event>& list, const TimePoint& now)
+{
+    // the priorities were worked out when the events were, so the copies
+    // sort without working anything out again
+    vector<Event> sorted(list);
+
+    std::sort(sorted.begin(), sorted.end(), ranksBefore);
+
+    blocks.clear();
+    keys.clear();
+
+    // chop the sorted events into blocks
+    for (size_t i = 0; i < sorted.size(); i += SORTED_BLOCK_SIZE)
+    {
+        size_t last = std::min(sorted.size(), i + SORTED_BLOCK_SIZE);
+
+        blocks.emplace_back(sorted.begin() + i, sorted.begin() + last);
+    }
+
+    for (auto &i : sorted)
+        keys[i.get_id()] = { i.get_priority(), i.get_due_minutes() };
+
+    recount();
+    count = sorted.size();
+    reference = now;
+    stale = false;
+}
+
+// put an event where it belongs
+void SortedView::insert(const Event& event)
+{
+    // it'll all be sorted from scratch anyway
+    if (stale)
+        return;
+
+    keys[event.get_id()] = { event.get_priority(), event.get_due_minutes() };
+    count++;
+
+    if (blocks.empty())
+    {
+        blocks.emplace_back(1, event);
+        recount();
+        return;
+    }
+
+    size_t b = findBlock(event);
+    vector<Event>& block = blocks[b];
+
+    block.insert(std::upper_bound(block.begin(), block.end(), event,
+        ranksBefore), event);
+
+    // split the block in half when it gets too big
+    if (block.size() >= 2 * SORTED_BLOCK_SIZE)
+    {
+        vector<Event> back(block.begin() + SORTED_BLOCK_SIZE, block.end());
+
+        block.erase(block.begin() + SORTED_BLOCK_SIZE, block.end());
+        blocks.insert(blocks.begin() + b + 1, std::move(back));
+        recount();
+    }
+    else
+        addCount(b, 1);
+}
+
+// take an event out
+void SortedView::erase(const Event& event)
+{
+    if (stale)
+        return;
+
+    auto found = keys.find(event.get_id());
+
+    if (found == keys.end())
+        return;
+
+    Key key = found->second;
+
+    // look through everything with the same priority and due date,
+    // which can run on into the blocks after the first
+    for (size_t b = findKeyBlock(key); b < blocks.size(); b++)
+    {
+        vector<Event>& block = blocks[b];
+        auto i = std::partition_point(block.begin(), block.end(),
+            [&key](const Event& e) { return keyBefore(e, key); });
+
+        for (; i != block.end(); ++i)
+        {
+            // went past everything with the same key
+            if (!sameKey(*i, key))
+                return;
+
+            if (i->get_id() == event.get_id())
+            {
+                block.erase(i);
+                if (block.empty())
+                {
+                    blocks.erase(blocks.begin() + b);
+                    recount();
+                }
+                else
+                    addCount(b, -1);
+
+                keys.erase(found);
+                count--;
+                return;
+            }
+        }
+    }
+}
+
+// get an iterator to a position
+SortedView::const_iterator SortedView::at(size_t pos) const
+{
+    size_t b = 0;
+    size_t step = 1;
+
+    if (pos >= count)
+        return end();
+
+    while (step * 2 <= blocks.size())
+        step *= 2;
+
+    // walk down the tree, skipping every run of blocks that ends before
+    // the position
+    for (; step > 0; step /= 2)
+    {
+        if (b + step <= blocks.size() && counts[b + step] <= pos)
+        {
+            b += step;
+            pos -= counts[b];
+        }
+    }
+
+    return const_iterator(&blocks, b, pos);
+}
+
+// find where the next page starts
+size_t SortedView::positionAfter(unsigned id) const
+{
+    auto found = keys.find(id);
+
+    if (found == keys.end())
+        return npos;
+
+    const Key& key = found->second;
+    size_t b = findKeyBlock(key);
+    size_t pos = b < blocks.size() ? countBefore(b) : 0;
+
+    for (; b < blocks.size(); b++)
+    {
+        const vector<Event>& block = blocks[b];
+        auto i = std::partition_point(block.begin(), block.end(),
+            [&key](const Event& e) { return keyBefore(e, key); });
+
+        pos += i - block.begin();
+
+        for (; i != block.end(); ++i, ++pos)
+        {
+            if (!sameKey(*i, key))
+                return npos;
+
+            if (i->get_id() == id)
+                return pos + 1;
+        }
+    }
+
+    return npos;
+}
+
+// rank two events, most important first
+bool SortedView::ranksBefore(const Event& a, const Event& b)
+{
+    if (a.get_priority() != b.get_priority())
+        return a.get_priority() > b.get_priority();
+    if (a.get_due_minutes() != b.get_due_minutes())
+        return a.get_due_minutes() < b.get_due_minutes();
+    return TITLES.name(a.get_title()) > TITLES.name(b.get_title());
+}
+
+// rank an event against a key, ignoring the name
+bool SortedView::keyBefore(const Event& a, const Key& b)
+{
+    if (a.get_priority() != b.priority)
+        return a.get_priority() > b.priority;
+    return a.get_due_minutes() < b.due;
+}
+
+// find the block an event goes in
+size_t SortedView::findBlock(const Event& event) const
+{
+    // the first block whose last event doesn't come before the new one
+    auto b = std::partition_point(blocks.begin(), blocks.end(),
+        [&event](const vector<Event>& block)
+        {
+            return ranksBefore(block.back(), event);
+        });
+
+    // past the end means it goes at the back of the last block
+    if (b == blocks.end())
+        return blocks.size() - 1;
+
+    return b - blocks.begin();
+}
+
+// find the first block for a key
+size_t SortedView::findKeyBlock(const Key& key) const
+{
+    return std::partition_point(blocks.begin(), blocks.end(),
+        [&key](const vector<Event>& block)
+        {
+            return keyBefore(block.back(), key);
+        }) - blocks.begin();
+}
+
+// count the blocks again
+void SortedView::recount()
+{
+    counts.assign(blocks.size() + 1, 0);
+
+    for (size_t i = 1; i <= blocks.size(); i++)
+    {
+        size_t parent = i + (i & (0 - i));
+
+        counts[i] += blocks[i - 1].size();
+        if (parent <= blocks.size())
+            counts[parent] += counts[i];
+    }
+}
+
+// change the count of a block
+void SortedView::addCount(size_t block, std::ptrdiff_t change)
+{
+    for (size_t i = block + 1; i <= blocks.size(); i += i & (0 - i))
+        counts[i] += change;
+}
+
+// count the events before a block
+size_t SortedView::countBefore(size_t block) const
+{
+    size_t before = 0;
+
+    for (size_t i = block; i > 0; i -= i & (0 - i))
+        before += counts[i];
+
+    return before;
+}